@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# 启动器拖动基准测试
+# 在Xvfb中无界面地运行启动器（--benchmark-drag），分别以coalesced和immediate方式模拟3秒的1000Hz拖动，
+# 汇总丢帧数、窗口移动次数、重绘次数和启动器进程的CPU占用（中位数）
+#
+# 用法: benchmark_drag.sh <flight_controls_launcher路径> [每种方式的运行次数] [输出目录]
+# 注意: Xvfb没有合成器和窗口管理器，system方式（_NET_WM_MOVERESIZE）无法在这里测量，
+#       X服务器和合成器的CPU也不计入结果
+
+set -e
+
+LAUNCHER="$1"
+RUNS="${2:-5}"
+OUTPUT_DIR="${3:-$(pwd)/drag_benchmark}"
+MODES="coalesced immediate"
+
+if [ -z "$LAUNCHER" ] || [ ! -x "$LAUNCHER" ]; then
+    echo "用法: $0 <flight_controls_launcher路径> [每种方式的运行次数] [输出目录]"
+    exit 1
+fi
+
+if [ -z "$FC_BENCHMARK_IN_XVFB" ]; then
+    if ! command -v xvfb-run >/dev/null 2>&1; then
+        echo "❌ 未找到xvfb-run，请安装: sudo apt-get install xvfb"
+        exit 1
+    fi
+    exec xvfb-run -a -s "-screen 0 1920x1080x24" env FC_BENCHMARK_IN_XVFB=1 bash "$0" "$@"
+fi
+
+# 独立的运行时目录：不与正在运行的启动器争用单实例锁
+export XDG_RUNTIME_DIR="$(mktemp -d)"
+trap 'rm -rf "$XDG_RUNTIME_DIR"' EXIT
+
+mkdir -p "$OUTPUT_DIR"
+rm -f "$OUTPUT_DIR"/*.json
+
+echo "========================================="
+echo "FlightControls 拖动基准测试"
+echo "========================================="
+echo "启动器: $LAUNCHER"
+echo "每种方式运行次数: $RUNS"
+echo "输出目录: $OUTPUT_DIR"
+echo ""
+
+for MODE in $MODES; do
+    for i in $(seq 1 "$RUNS"); do
+        RESULT="$OUTPUT_DIR/${MODE}_$i.json"
+        if ! timeout 30s "$LAUNCHER" --drag-mode="$MODE" --benchmark-drag="$RESULT" >/dev/null 2>&1 \
+                || [ ! -s "$RESULT" ]; then
+            echo "❌ $MODE 第 $i 次运行未生成结果"
+            exit 1
+        fi
+        printf "."
+    done
+done
+echo ""
+echo ""
+
+# 每个字段取中位数
+SUMMARY="$OUTPUT_DIR/summary.txt"
+printf "%-12s %10s %10s %10s %10s %10s\n" "方式" "移动事件" "窗口移动" "重绘" "丢帧" "CPU%" > "$SUMMARY"
+for MODE in $MODES; do
+    LINE="$MODE"
+    for FIELD in motion_events window_moves paints dropped_frames cpu_percent; do
+        MEDIAN=$(cat "$OUTPUT_DIR/${MODE}"_*.json \
+            | sed -n "s/.*\"$FIELD\":\([0-9.]*\).*/\1/p" \
+            | sort -g \
+            | awk '{ v[NR] = $1 } END { printf "%.1f", v[int((NR + 1) / 2)] }')
+        LINE="$LINE $MEDIAN"
+    done
+    echo "$LINE" | awk '{ printf "%-12s %10s %10s %10s %10s %10s\n", $1, $2, $3, $4, $5, $6 }' >> "$SUMMARY"
+done
+
+cat "$SUMMARY"
+echo ""
+echo "丢帧: 帧时钟（屏幕刷新周期）因事件循环阻塞而错过的周期数；CPU%: 启动器进程，100%为占满一个核心"
@@ -0,0 +1,96 @@
+#!/bin/bash
+
+# 启动器启动耗时基准测试
+# 在Xvfb中无界面地运行启动器N次（--trace-startup --trace-startup-quit），
+# 汇总各阶段耗时及main()到首帧的总耗时，输出百分位数
+#
+# 用法: benchmark_startup.sh <flight_controls_launcher路径> [运行次数] [输出目录]
+# 环境变量: STARTUP_BUDGET_MS - 若设置，首帧耗时P90超过该值时返回非零（用于打包时检测回归）
+
+set -e
+
+LAUNCHER="$1"
+RUNS="${2:-20}"
+OUTPUT_DIR="${3:-$(pwd)/startup_benchmark}"
+
+if [ -z "$LAUNCHER" ] || [ ! -x "$LAUNCHER" ]; then
+    echo "用法: $0 <flight_controls_launcher路径> [运行次数] [输出目录]"
+    exit 1
+fi
+
+# 所有运行共用同一个Xvfb服务器，避免把X服务器启动时间计入结果
+if [ -z "$FC_BENCHMARK_IN_XVFB" ]; then
+    if ! command -v xvfb-run >/dev/null 2>&1; then
+        echo "❌ 未找到xvfb-run，请安装: sudo apt-get install xvfb"
+        exit 1
+    fi
+    exec xvfb-run -a -s "-screen 0 1920x1080x24" env FC_BENCHMARK_IN_XVFB=1 bash "$0" "$@"
+fi
+
+mkdir -p "$OUTPUT_DIR"
+rm -f "$OUTPUT_DIR"/run_*.json
+SAMPLES="$OUTPUT_DIR/samples.txt"
+: > "$SAMPLES"
+
+echo "========================================="
+echo "FlightControls 启动耗时基准测试"
+echo "========================================="
+echo "启动器: $LAUNCHER"
+echo "运行次数: $RUNS"
+echo "输出目录: $OUTPUT_DIR"
+echo ""
+
+# 预热一次（加载共享库到页缓存），不计入结果
+timeout 30s "$LAUNCHER" --trace-startup="$OUTPUT_DIR/warmup.json" --trace-startup-quit >/dev/null 2>&1 || true
+
+for i in $(seq 1 "$RUNS"); do
+    TRACE_FILE="$OUTPUT_DIR/run_$i.json"
+    if ! timeout 30s "$LAUNCHER" --trace-startup="$TRACE_FILE" --trace-startup-quit >/dev/null 2>&1 \
+            || [ ! -s "$TRACE_FILE" ]; then
+        echo "❌ 第 $i 次运行未生成跟踪文件"
+        exit 1
+    fi
+
+    # 每行一个事件：计算各阶段(B/E)耗时和首帧时间，单位毫秒
+    awk '
+        match($0, /"name":"[^"]*"/) {
+            name = substr($0, RSTART + 8, RLENGTH - 9)
+            match($0, /"ph":"."/); phase = substr($0, RSTART + 6, 1)
+            match($0, /"ts":[0-9.]+/); ts = substr($0, RSTART + 5, RLENGTH - 5) + 0
+            if (phase == "B") { begin[name] = ts }
+            else if (phase == "E" && (name in begin)) { printf "%s %.3f\n", name, (ts - begin[name]) / 1000.0 }
+            else if (phase == "i" && name == "first-frame") { printf "total(main→first-frame) %.3f\n", ts / 1000.0 }
+        }
+    ' "$TRACE_FILE" >> "$SAMPLES"
+    printf "."
+done
+echo ""
+echo ""
+
+# 按阶段计算百分位数（nearest-rank）
+SUMMARY="$OUTPUT_DIR/summary.txt"
+printf "%-32s %9s %9s %9s %9s %9s\n" "阶段" "min" "p50" "p90" "p99" "max" > "$SUMMARY"
+for PHASE in $(awk '{print $1}' "$SAMPLES" | sort -u); do
+    sort -g -k2 <(awk -v p="$PHASE" '$1 == p {print $1, $2}' "$SAMPLES") | awk '
+        { v[NR] = $2 }
+        END {
+            n = NR
+            p50 = int(n * 0.50 + 0.999); if (p50 < 1) p50 = 1
+            p90 = int(n * 0.90 + 0.999); if (p90 < 1) p90 = 1
+            p99 = int(n * 0.99 + 0.999); if (p99 < 1) p99 = 1
+            printf "%-32s %9.2f %9.2f %9.2f %9.2f %9.2f\n", $1, v[1], v[p50], v[p90], v[p99], v[n]
+        }' >> "$SUMMARY"
+done
+
+cat "$SUMMARY"
+echo ""
+echo "单位: 毫秒；原始跟踪文件可在 chrome://tracing 或 https://ui.perfetto.dev 中打开"
+
+if [ -n "$STARTUP_BUDGET_MS" ]; then
+    P90=$(awk '$1 ~ /^total/ {print $4}' "$SUMMARY")
+    if awk -v p="$P90" -v b="$STARTUP_BUDGET_MS" 'BEGIN { exit !(p > b) }'; then
+        echo "❌ 首帧耗时P90 ${P90}ms 超出预算 ${STARTUP_BUDGET_MS}ms"
+        exit 1
+    fi
+    echo "✅ 首帧耗时P90 ${P90}ms 在预算 ${STARTUP_BUDGET_MS}ms 之内"
+fi
@@ -92,6 +92,7 @@ install_x11() {
     sudo apt-get install -y \
         libx11-dev \
         libx11-6 \
+        libxcb1-dev \
         x11-utils \
         xorg-dev
     
@@ -0,0 +1,187 @@
+#include "AppImagePrewarmer.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char *kCompleteMarker = ".complete";  // 解包完成标记，防止使用中断的半成品
+
+    // 在线程池中遍历解包目录，提示内核异步预读可执行文件和库
+    class ReadaheadTask : public QRunnable
+    {
+    public:
+        explicit ReadaheadTask(const QString &rootDir) : m_rootDir(rootDir) {}
+
+        void run() override
+        {
+            int fileCount = 0;
+            qint64 totalBytes = 0;
+            QDirIterator it(m_rootDir, QDir::Files | QDir::NoSymLinks, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                const QString path = it.next();
+                const QFileInfo info = it.fileInfo();
+                // 只预读启动时一定会加载的文件：可执行文件和共享库
+                if (!info.isExecutable() && !info.fileName().contains(".so")) {
+                    continue;
+                }
+#ifdef Q_OS_UNIX
+                int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) {
+                    continue;
+                }
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                ::close(fd);
+#endif
+                ++fileCount;
+                totalBytes += info.size();
+            }
+            qDebug() << "AppImage预读完成，文件数:" << fileCount
+                     << "大小:" << (totalBytes / (1024 * 1024)) << "MB";
+        }
+
+    private:
+        QString m_rootDir;
+    };
+}
+
+AppImagePrewarmer::AppImagePrewarmer(QObject *parent)
+    : QObject(parent)
+    , m_extractProcess(nullptr)
+{
+}
+
+QString AppImagePrewarmer::cacheRoot()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/appimage_cache";
+}
+
+QString AppImagePrewarmer::cacheDirFor(const QString &appImagePath) const
+{
+    QFileInfo info(appImagePath);
+    QByteArray key = QFile::encodeName(info.absoluteFilePath()) + '|'
+            + QByteArray::number(info.size()) + '|'
+            + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    QString hash = QString::fromLatin1(QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex().left(12));
+    return cacheRoot() + "/" + info.completeBaseName() + "-" + hash;
+}
+
+QString AppImagePrewarmer::executable() const
+{
+    // 缓存可能被手动清理，AppImage也可能在运行期间被更新，使用前再确认一次
+    if (m_executable.isEmpty() || !QFileInfo(m_executable).isExecutable()
+            || cacheDirFor(m_appImagePath) != m_cacheDir) {
+        return QString();
+    }
+    return m_executable;
+}
+
+void AppImagePrewarmer::start(const QString &appImagePath)
+{
+    if (m_extractProcess) {
+        qDebug() << "AppImage预热进行中";
+        return;
+    }
+
+    m_appImagePath = appImagePath;
+    m_cacheDir = cacheDirFor(appImagePath);
+    m_executable.clear();
+
+    QDir cacheDir(m_cacheDir);
+    if (QFileInfo::exists(cacheDir.filePath(kCompleteMarker))) {
+        qDebug() << "使用已解包的AppImage缓存:" << m_cacheDir;
+        finishPrewarm(m_cacheDir);
+        return;
+    }
+
+    // 解包到临时目录，完成后再改名，避免中断留下不完整的缓存
+    QString partialDir = m_cacheDir + ".partial";
+    QDir(partialDir).removeRecursively();
+    if (!QDir().mkpath(partialDir)) {
+        emit failed("无法创建AppImage缓存目录: " + partialDir);
+        return;
+    }
+
+    qDebug() << "开始解包AppImage:" << appImagePath << "→" << m_cacheDir;
+    m_extractProcess = new QProcess(this);
+    m_extractProcess->setWorkingDirectory(partialDir);  // --appimage-extract解包到当前目录的squashfs-root
+    m_extractProcess->setStandardOutputFile(QProcess::nullDevice());
+    m_extractProcess->setStandardErrorFile(QProcess::nullDevice());
+    connect(m_extractProcess, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &AppImagePrewarmer::onExtractFinished);
+    connect(m_extractProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onExtractFinished(-1, QProcess::CrashExit);
+        }
+    });
+    m_extractProcess->start(appImagePath, QStringList() << "--appimage-extract");
+}
+
+void AppImagePrewarmer::onExtractFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    m_extractProcess->deleteLater();
+    m_extractProcess = nullptr;
+
+    QString partialDir = m_cacheDir + ".partial";
+    bool extracted = exitStatus == QProcess::NormalExit && exitCode == 0
+            && QFileInfo(partialDir + "/squashfs-root/AppRun").exists();
+    if (!extracted) {
+        QDir(partialDir).removeRecursively();
+        qWarning() << "AppImage解包失败，退出代码:" << exitCode;
+        emit failed("AppImage解包失败");
+        return;
+    }
+
+    QDir(m_cacheDir).removeRecursively();
+    QFile marker(m_cacheDir + "/" + kCompleteMarker);
+    if (!QDir().rename(partialDir, m_cacheDir) || !marker.open(QIODevice::WriteOnly)) {
+        QDir(partialDir).removeRecursively();
+        emit failed("无法写入AppImage缓存: " + m_cacheDir);
+        return;
+    }
+    marker.close();
+
+    removeStaleCaches(m_cacheDir);
+    finishPrewarm(m_cacheDir);
+}
+
+void AppImagePrewarmer::finishPrewarm(const QString &extractDir)
+{
+    QString rootDir = extractDir + "/squashfs-root";
+    m_executable = rootDir + "/AppRun";
+
+    QThreadPool::globalInstance()->start(new ReadaheadTask(rootDir));
+
+    qDebug() << "AppImage预热完成，之后直接启动:" << m_executable;
+    emit ready(m_executable);
+}
+
+void AppImagePrewarmer::removeStaleCaches(const QString &keepDir) const
+{
+    // AppImage更新后旧的解包目录不再使用（每个约数百MB）。
+    // 每个声明了prewarm的应用各有一个预热器：只删除本AppImage的旧缓存，
+    // 其他AppImage的缓存和正在解包的.partial目录保持不动
+    const QString keepName = QFileInfo(keepDir).fileName();
+    const QRegularExpression ownCache("^" + QRegularExpression::escape(QFileInfo(m_appImagePath).completeBaseName())
+                                      + "-[0-9a-f]{12}$");
+    QDir root(cacheRoot());
+    const QStringList entries = root.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &name : entries) {
+        if (name != keepName && ownCache.match(name).hasMatch()) {
+            qDebug() << "删除过期的AppImage缓存:" << root.filePath(name);
+            QDir(root.filePath(name)).removeRecursively();
+        }
+    }
+}
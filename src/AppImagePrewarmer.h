@@ -0,0 +1,51 @@
+#ifndef APPIMAGEPREWARMER_H
+#define APPIMAGEPREWARMER_H
+
+#include <QObject>
+#include <QProcess>
+
+/**
+ * @brief AppImage预热（--prewarm-qgc）
+ *
+ * 启动器启动后在后台把AppImage用--appimage-extract解包到AppDataLocation下的缓存目录，
+ * 并通过posix_fadvise(WILLNEED)把主程序和库文件预读到页缓存。
+ * 之后的启动直接执行解包后的AppRun，省去每次FUSE挂载和squashfs解压的开销。
+ * 缓存目录以AppImage的路径、大小和修改时间为键，AppImage更新后自动重新解包
+ */
+class AppImagePrewarmer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AppImagePrewarmer(QObject *parent = nullptr);
+
+    // 异步预热；缓存已存在时只做预读
+    void start(const QString &appImagePath);
+
+    bool isReady() const { return !m_executable.isEmpty(); }
+    QString appImagePath() const { return m_appImagePath; }
+
+    // 解包后的可执行入口（未就绪或缓存已失效时为空）
+    QString executable() const;
+
+    static QString cacheRoot();
+
+signals:
+    void ready(const QString &executable);
+    void failed(const QString &reason);
+
+private slots:
+    void onExtractFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
+private:
+    QString cacheDirFor(const QString &appImagePath) const;
+    void finishPrewarm(const QString &extractDir);
+    void removeStaleCaches(const QString &keepDir) const;
+
+    QProcess *m_extractProcess;
+    QString m_appImagePath;
+    QString m_cacheDir;
+    QString m_executable;
+};
+
+#endif // APPIMAGEPREWARMER_H
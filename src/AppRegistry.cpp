@@ -0,0 +1,359 @@
+#include "AppRegistry.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QDebug>
+#include <functional>
+
+namespace {
+    QStringList toStringList(const QJsonValue &value)
+    {
+        QStringList result;
+        const QJsonArray array = value.toArray();
+        for (const QJsonValue &item : array) {
+            result << item.toString();
+        }
+        return result;
+    }
+
+    bool validateReadiness(const AppDefinition &app, QString *error)
+    {
+        const AppDefinition::Readiness &readiness = app.readiness;
+        QString problem;
+        if (readiness.type == "tcp" || readiness.type == "udp") {
+            if ((readiness.port <= 0 || readiness.port > 65535) && readiness.urlVariable.isEmpty()) {
+                problem = "缺少有效的port";
+            }
+        } else if (readiness.type == "file") {
+            if (readiness.path.isEmpty()) {
+                problem = "缺少path";
+            }
+        } else if (readiness.type == "log") {
+            QRegularExpression pattern(readiness.pattern);
+            if (readiness.pattern.isEmpty() || !pattern.isValid()) {
+                problem = "pattern为空或不是有效的正则表达式";
+            }
+        } else if (readiness.type == "window") {
+            if (!app.hasWindow()) {
+                problem = "没有声明window";
+            }
+        } else if (readiness.type != "none") {
+            problem = QString("类型不受支持: %1").arg(readiness.type);
+        }
+
+        if (!problem.isEmpty()) {
+            *error = QString("应用程序 %1 的就绪探测%2").arg(app.id, problem);
+            return false;
+        }
+        return true;
+    }
+
+    // 内存大小：字节数，或带K/M/G后缀的字符串（如"2G"）；格式错误返回-1
+    qint64 parseSize(const QJsonValue &value)
+    {
+        if (value.isUndefined() || value.isNull()) {
+            return 0;
+        }
+        if (value.isDouble()) {
+            return value.toDouble() >= 0 ? static_cast<qint64>(value.toDouble()) : -1;
+        }
+
+        QString text = value.toString().trimmed().toUpper();
+        qint64 multiplier = 1;
+        if (text.endsWith('K')) {
+            multiplier = 1024;
+        } else if (text.endsWith('M')) {
+            multiplier = 1024 * 1024;
+        } else if (text.endsWith('G')) {
+            multiplier = 1024LL * 1024 * 1024;
+        }
+        if (multiplier > 1) {
+            text.chop(1);
+        }
+        bool ok = false;
+        double number = text.toDouble(&ok);
+        return ok && number >= 0 ? static_cast<qint64>(number * multiplier) : -1;
+    }
+
+    bool parseResources(const QJsonObject &resources, AppDefinition &app, QString *error)
+    {
+        AppDefinition::ResourcePolicy &policy = app.resources;
+        QString problem;
+        if (resources.contains("nice")) {
+            policy.hasNice = true;
+            policy.nice = resources.value("nice").toInt(0);
+            if (policy.nice < -20 || policy.nice > 19) {
+                problem = "nice必须在-20到19之间";
+            }
+        }
+        policy.scheduler = resources.value("scheduler").toString();
+        policy.priority = resources.value("priority").toInt(0);
+        static const QStringList schedulers = {"other", "batch", "idle", "fifo", "rr"};
+        bool realtime = policy.scheduler == "fifo" || policy.scheduler == "rr";
+        if (!policy.scheduler.isEmpty() && !schedulers.contains(policy.scheduler)) {
+            problem = QString("scheduler不受支持: %1").arg(policy.scheduler);
+        } else if (realtime && (policy.priority < 1 || policy.priority > 99)) {
+            problem = "fifo/rr需要1到99之间的priority";
+        }
+        const QJsonArray cpus = resources.value("cpus").toArray();
+        for (const QJsonValue &cpu : cpus) {
+            if (cpu.toInt(-1) < 0) {
+                problem = "cpus必须是CPU编号的数组";
+            }
+            policy.cpus << cpu.toInt(-1);
+        }
+        policy.cpuMax = resources.value("cpuMax").toInt(0);
+        policy.memoryMax = parseSize(resources.value("memoryMax"));
+        if (policy.cpuMax < 0) {
+            problem = "cpuMax不能为负数";
+        } else if (policy.memoryMax < 0) {
+            problem = "memoryMax应为字节数或带K/M/G后缀的字符串";
+        }
+
+        if (!problem.isEmpty()) {
+            *error = QString("应用程序 %1 的资源策略: %2").arg(app.id, problem);
+            return false;
+        }
+        return true;
+    }
+
+    // 搜索路径支持${APPDIR}（启动器所在目录）和~（用户主目录）
+    QString expandPath(QString path)
+    {
+        path.replace("${APPDIR}", QCoreApplication::applicationDirPath());
+        if (path.startsWith("~/")) {
+            path.replace(0, 1, QDir::homePath());
+        }
+        return path;
+    }
+}
+
+QString AppRegistry::userConfigPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/applications.json";
+}
+
+QString AppRegistry::builtinPath()
+{
+    return ":/config/applications.json";
+}
+
+bool AppRegistry::load(const QString &path, QString *error)
+{
+    QString sourcePath = path;
+    if (sourcePath.isEmpty()) {
+        sourcePath = QFileInfo::exists(userConfigPath()) ? userConfigPath() : builtinPath();
+    }
+
+    QFile file(sourcePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = QString("无法读取应用程序配置: %1").arg(sourcePath);
+        return false;
+    }
+
+    if (!parse(file.readAll(), error)) {
+        *error = QString("%1: %2").arg(sourcePath, *error);
+        return false;
+    }
+
+    m_sourcePath = sourcePath;
+    qDebug() << "已加载应用程序配置:" << sourcePath << "应用数:" << m_applications.size()
+             << "启动配置数:" << m_profiles.size();
+    return true;
+}
+
+bool AppRegistry::parse(const QByteArray &data, QString *error)
+{
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (document.isNull()) {
+        *error = QString("JSON格式错误: %1").arg(parseError.errorString());
+        return false;
+    }
+
+    QVector<AppDefinition> applications;
+    QHash<QString, int> index;
+    const QJsonArray entries = document.object().value("applications").toArray();
+    for (const QJsonValue &entryValue : entries) {
+        const QJsonObject entry = entryValue.toObject();
+
+        AppDefinition app;
+        app.id = entry.value("id").toString();
+        if (app.id.isEmpty() || index.contains(app.id)) {
+            *error = QString("应用程序id为空或重复: \"%1\"").arg(app.id);
+            return false;
+        }
+        app.label = entry.value("label").toString(app.id);
+        app.icon = entry.value("icon").toString();
+        app.color = entry.value("color").toString("#607D8B");
+        app.showButton = entry.value("button").toBool(true);
+
+        app.program = entry.value("program").toString();
+        if (app.program.isEmpty()) {
+            *error = QString("应用程序 %1 缺少program").arg(app.id);
+            return false;
+        }
+        app.arguments = toStringList(entry.value("arguments"));
+        for (const QString &searchPath : toStringList(entry.value("searchPaths"))) {
+            app.searchPaths << expandPath(searchPath);
+        }
+        app.environment = entry.value("environment").toString("system");
+        const QJsonObject extraEnvironment = entry.value("env").toObject();
+        for (auto it = extraEnvironment.constBegin(); it != extraEnvironment.constEnd(); ++it) {
+            app.extraEnvironment.insert(it.key(), it.value().toString());
+        }
+        app.prewarm = entry.value("prewarm").toBool(false);
+        app.missingMessage = entry.value("missingMessage").toString();
+
+        app.dependsOn = toStringList(entry.value("dependsOn"));
+        app.reuseExisting = entry.value("reuseExisting").toBool(false);
+
+        const QJsonObject readiness = entry.value("readiness").toObject();
+        app.readiness.type = readiness.value("type").toString("none");
+        app.readiness.host = readiness.value("host").toString("localhost");
+        app.readiness.port = readiness.value("port").toInt(0);
+        app.readiness.urlVariable = readiness.value("urlVariable").toString();
+        app.readiness.path = expandPath(readiness.value("path").toString());
+        app.readiness.pattern = readiness.value("pattern").toString();
+        app.readiness.timeout = readiness.value("timeout").toInt(20000);
+        app.readiness.failOnTimeout = readiness.value("failOnTimeout").toBool(true);
+
+        const QJsonObject window = entry.value("window").toObject();
+        app.windowTitles = toStringList(window.value("titles"));
+        app.windowClass = window.value("class").toString();
+        app.windowSearchDelay = window.value("searchDelay").toInt(5000);
+        if (!validateReadiness(app, error)) {
+            return false;
+        }
+
+        app.stopTimeout = entry.value("stop").toObject().value("timeout").toInt(3000);
+
+        const QJsonObject restart = entry.value("restart").toObject();
+        app.restart.enabled = restart.value("enabled").toBool(false);
+        app.restart.initialDelay = qMax(0, restart.value("initialDelay").toInt(1000));
+        app.restart.maxDelay = qMax(app.restart.initialDelay, restart.value("maxDelay").toInt(30000));
+        app.restart.maxRestarts = restart.value("maxRestarts").toInt(5);
+        app.restart.window = restart.value("window").toInt(600000);
+        app.restart.minUptime = restart.value("minUptime").toInt(10000);
+        app.restart.crashLoopThreshold = qMax(1, restart.value("crashLoopThreshold").toInt(3));
+
+        if (!parseResources(entry.value("resources").toObject(), app, error)) {
+            return false;
+        }
+
+        const QJsonObject terminalFallback = entry.value("terminalFallback").toObject();
+        app.terminalCommand = terminalFallback.value("command").toString();
+        app.terminalSweepPatterns = toStringList(terminalFallback.value("sweep"));
+
+        index.insert(app.id, applications.size());
+        applications.append(app);
+    }
+
+    if (applications.isEmpty()) {
+        *error = "没有定义任何应用程序";
+        return false;
+    }
+
+    m_applications.swap(applications);
+    m_index.swap(index);
+    return resolveDependencies(error)
+            && parseProfiles(document.object().value("profiles").toArray(), error);
+}
+
+bool AppRegistry::parseProfiles(const QJsonArray &entries, QString *error)
+{
+    QVector<LaunchProfile> profiles;
+    for (const QJsonValue &entryValue : entries) {
+        const QJsonObject entry = entryValue.toObject();
+
+        LaunchProfile profile;
+        profile.id = entry.value("id").toString();
+        if (profile.id.isEmpty()) {
+            *error = "启动配置id为空";
+            return false;
+        }
+        for (const LaunchProfile &existing : profiles) {
+            if (existing.id == profile.id) {
+                *error = QString("启动配置id重复: \"%1\"").arg(profile.id);
+                return false;
+            }
+        }
+        profile.label = entry.value("label").toString(profile.id);
+        profile.icon = entry.value("icon").toString("▶");
+        profile.color = entry.value("color").toString("#FF9800");
+        profile.applications = toStringList(entry.value("applications"));
+        if (profile.applications.isEmpty()) {
+            *error = QString("启动配置 %1 没有包含任何应用程序").arg(profile.id);
+            return false;
+        }
+        for (const QString &application : profile.applications) {
+            int applicationIndex = m_index.value(application, -1);
+            if (applicationIndex < 0) {
+                *error = QString("启动配置 %1 包含未定义的应用程序 %2").arg(profile.id, application);
+                return false;
+            }
+            profile.members << applicationIndex;
+        }
+        profiles.append(profile);
+    }
+
+    m_profiles.swap(profiles);
+    return true;
+}
+
+int AppRegistry::profileIndexOf(const QString &id) const
+{
+    for (int i = 0; i < m_profiles.size(); ++i) {
+        if (m_profiles[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool AppRegistry::resolveDependencies(QString *error)
+{
+    for (AppDefinition &app : m_applications) {
+        app.dependencies.clear();
+        for (const QString &dependency : app.dependsOn) {
+            int dependencyIndex = m_index.value(dependency, -1);
+            if (dependencyIndex < 0) {
+                *error = QString("应用程序 %1 依赖未定义的 %2").arg(app.id, dependency);
+                return false;
+            }
+            app.dependencies << dependencyIndex;
+        }
+    }
+
+    // 检查循环依赖（0-未访问，1-访问中，2-已完成）
+    QVector<int> state(m_applications.size(), 0);
+    std::function<bool(int)> visit = [&](int i) {
+        if (state[i] == 1) {
+            return false;
+        }
+        if (state[i] == 2) {
+            return true;
+        }
+        state[i] = 1;
+        for (int dependency : m_applications[i].dependencies) {
+            if (!visit(dependency)) {
+                return false;
+            }
+        }
+        state[i] = 2;
+        return true;
+    };
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (!visit(i)) {
+            *error = QString("应用程序 %1 存在循环依赖").arg(m_applications[i].id);
+            return false;
+        }
+    }
+    return true;
+}
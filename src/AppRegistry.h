@@ -0,0 +1,144 @@
+#ifndef APPREGISTRY_H
+#define APPREGISTRY_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QJsonArray;
+
+/**
+ * @brief 单个应用程序的声明（来自applications.json）
+ *
+ * 描述如何启动（命令、环境、依赖）、何时算就绪、如何找到窗口以及如何停止，
+ * 启动器据此统一处理所有应用程序，不再按名称分支
+ */
+struct AppDefinition {
+    // 就绪探测：依赖该应用的其他应用在就绪后才启动
+    struct Readiness {
+        // "none" - 进程启动即就绪；"tcp" - 端口可连接；"udp" - 端口已被绑定；
+        // "file" - 文件出现；"log" - 输出中出现匹配的行；"window" - 窗口已映射
+        QString type = "none";
+        QString host = "localhost";
+        int port = 0;
+        QString urlVariable;     // 从该环境变量（如ROS_MASTER_URI）读取主机和端口
+        QString path;            // file
+        QString pattern;         // log（正则表达式）
+        int timeout = 20000;     // 毫秒
+        bool failOnTimeout = true;  // false时超时仍视为就绪（只是不再提前推进）
+
+        // 启动前即可判断是否已有现成实例的探测类型
+        bool canDetectExisting() const { return type == "tcp" || type == "udp" || type == "file"; }
+    };
+
+    // 崩溃自动重启：退出代码非0或异常终止时按指数退避重启
+    struct RestartPolicy {
+        bool enabled = false;
+        int initialDelay = 1000;     // 第一次重启前的等待（毫秒），之后每次翻倍
+        int maxDelay = 30000;        // 退避上限（毫秒）
+        int maxRestarts = 5;         // 预算：window时间内最多重启次数
+        int window = 600000;         // 预算统计窗口（毫秒）
+        int minUptime = 10000;       // 运行超过该时间视为稳定，退避和崩溃循环计数清零
+        int crashLoopThreshold = 3;  // 连续这么多次在minUptime内崩溃即判定为崩溃循环，停止重启
+    };
+
+    // 调度和资源限制：在子进程exec之前应用；cpuMax/memoryMax使用启动器所属的cgroup v2子组
+    struct ResourcePolicy {
+        bool hasNice = false;
+        int nice = 0;                // -20..19，降低nice值需要CAP_SYS_NICE
+        QString scheduler;           // 空（不修改）、"other"、"batch"、"idle"、"fifo"、"rr"
+        int priority = 0;            // fifo/rr的优先级（1..99）
+        QList<int> cpus;             // CPU亲和性，为空表示不限制
+        int cpuMax = 0;              // CPU上限（百分比，100为一个核心），0表示不限制
+        qint64 memoryMax = 0;        // 内存上限（字节），0表示不限制
+
+        bool usesCgroup() const { return cpuMax > 0 || memoryMax > 0; }
+        bool isEmpty() const { return !hasNice && scheduler.isEmpty() && cpus.isEmpty() && !usesCgroup(); }
+    };
+
+    QString id;                  // 唯一标识，例如"QGC"
+    QString label;               // 按钮和状态中显示的名称
+    QString icon;
+    QString color;               // 按钮主色
+    bool showButton = true;      // 仅作为依赖的应用（如roscore）不显示按钮
+
+    QString program;
+    QStringList arguments;
+    QStringList searchPaths;     // 非空时按顺序查找程序的完整路径（结果缓存）
+    QString environment = "system";  // "system" 或 "ros"（使用解析后的ROS环境和PATH）
+    QMap<QString, QString> extraEnvironment;
+    bool prewarm = false;        // 程序为AppImage时允许预热解包
+    QString missingMessage;      // 找不到程序时的提示
+
+    QStringList dependsOn;
+    QVector<int> dependencies;   // dependsOn在注册表中的下标（加载时计算）
+    bool reuseExisting = false;  // 启动前就绪探测已通过时直接使用已有实例，不再启动（仅tcp/udp/file）
+    Readiness readiness;
+
+    QStringList windowTitles;    // 窗口标题匹配（不区分大小写，仅在无法按进程匹配时使用）
+    QString windowClass;         // WM_CLASS匹配
+    int windowSearchDelay = 5000; // 定时轮询模式下首次搜索窗口的延迟（声明了就绪探测时就绪后立即搜索）
+
+    int stopTimeout = 3000;      // SIGTERM后等待的毫秒数
+    RestartPolicy restart;
+    ResourcePolicy resources;
+
+    QString terminalCommand;     // 无法解析ROS环境时在终端中执行的命令（可选）
+    QStringList terminalSweepPatterns; // 终端启动后只能按这些模式清理
+
+    bool hasWindow() const { return !windowTitles.isEmpty() || !windowClass.isEmpty(); }
+    bool usesRosEnvironment() const { return environment == "ros"; }
+};
+
+/**
+ * @brief 启动配置（applications.json中的profiles）
+ *
+ * 一组一起启动的应用程序，例如"mission" = QGC + RVIZ（roscore作为RVIZ的依赖自动启动）。
+ * 成员之间没有依赖关系的并行启动，有依赖的在依赖就绪后立即启动
+ */
+struct LaunchProfile {
+    QString id;
+    QString label;
+    QString icon;
+    QString color;
+    QStringList applications;
+    QVector<int> members;        // applications在注册表中的下标（加载时计算）
+};
+
+/**
+ * @brief 应用程序注册表
+ *
+ * 从JSON文件加载应用程序声明，并预先计算id到下标的索引和依赖关系，
+ * 运行时按下标访问，不再反复按字符串查找。
+ * 默认使用用户配置目录中的applications.json，不存在时使用内置配置
+ */
+class AppRegistry
+{
+public:
+    // path为空时依次尝试userConfigPath()和内置配置
+    bool load(const QString &path, QString *error);
+
+    const QVector<AppDefinition> &applications() const { return m_applications; }
+    int indexOf(const QString &id) const { return m_index.value(id, -1); }
+    const QVector<LaunchProfile> &profiles() const { return m_profiles; }
+    int profileIndexOf(const QString &id) const;
+    QString sourcePath() const { return m_sourcePath; }
+
+    static QString userConfigPath();
+    static QString builtinPath();
+
+private:
+    bool parse(const QByteArray &data, QString *error);
+    bool resolveDependencies(QString *error);
+    bool parseProfiles(const QJsonArray &entries, QString *error);
+
+    QVector<AppDefinition> m_applications;
+    QVector<LaunchProfile> m_profiles;
+    QHash<QString, int> m_index;
+    QString m_sourcePath;
+};
+
+#endif // APPREGISTRY_H
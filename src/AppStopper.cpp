@@ -0,0 +1,257 @@
+#include "AppStopper.h"
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#include <sys/types.h>
+#include <errno.h>
+#endif
+
+AppStopper::AppStopper(const QString &appName, QProcess *process, const Plan &plan, QObject *parent)
+    : QObject(parent)
+    , m_appName(appName)
+    , m_process(process)
+    , m_plan(plan)
+    , m_stage(Stage::Idle)
+    , m_deadlineTimer(nullptr)
+    , m_pollTimer(nullptr)
+    , m_verifyProcess(nullptr)
+    , m_pendingSweeps(0)
+    , m_forced(false)
+{
+    // 无效的进程组ID（未启动或未记录）不能用于kill(-pgid)，只保留有效值；全部无效时退回QProcess
+    m_plan.processGroupIds.erase(std::remove_if(m_plan.processGroupIds.begin(), m_plan.processGroupIds.end(),
+                                                [](qint64 processGroupId) { return processGroupId <= 0; }),
+                                 m_plan.processGroupIds.end());
+    
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &AppStopper::onDeadline);
+    
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(m_plan.pollInterval);
+    connect(m_pollTimer, &QTimer::timeout, this, &AppStopper::onPoll);
+}
+
+void AppStopper::start()
+{
+    if (m_stage != Stage::Idle) {
+        return;
+    }
+
+    if (!targetExited()) {
+        qDebug() << "尝试优雅停止" << m_appName << "，进程组:" << m_plan.processGroupIds;
+        enterStage(Stage::Terminating);
+    } else {
+        qDebug() << m_appName << "没有可跟踪的进程组，直接执行清理";
+        enterStage(Stage::Sweeping);
+    }
+}
+
+void AppStopper::signalTarget(bool force)
+{
+#ifdef Q_OS_UNIX
+    if (!m_plan.processGroupIds.isEmpty()) {
+        // 负PID表示向整个进程组发送信号，无需创建任何子进程
+        for (qint64 processGroupId : m_plan.processGroupIds) {
+            if (processGroupId > 0 && ::kill(static_cast<pid_t>(-processGroupId), force ? SIGKILL : SIGTERM) != 0
+                    && errno != ESRCH) {
+                qWarning() << "向进程组" << processGroupId << "发送信号失败，errno:" << errno;
+            }
+        }
+        return;
+    }
+#endif
+    if (m_process) {
+        if (force) {
+            m_process->kill();
+        } else {
+            m_process->terminate();
+        }
+    }
+}
+
+bool AppStopper::targetExited() const
+{
+#ifdef Q_OS_UNIX
+    if (!m_plan.processGroupIds.isEmpty()) {
+        // 信号0只检查进程组中是否仍有进程存在
+        for (qint64 processGroupId : m_plan.processGroupIds) {
+            if (processGroupId > 0 && !(::kill(static_cast<pid_t>(-processGroupId), 0) != 0 && errno == ESRCH)) {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+    return !m_process || m_process->state() == QProcess::NotRunning;
+}
+
+void AppStopper::enterStage(Stage stage)
+{
+    m_stage = stage;
+
+    switch (stage) {
+    case Stage::Terminating:
+        signalTarget(false);
+        m_deadlineTimer->start(m_plan.terminateTimeout);
+        m_pollTimer->start();
+        break;
+    case Stage::Killing:
+        m_forced = true;
+        signalTarget(true);
+        m_deadlineTimer->start(m_plan.killTimeout);
+        break;
+    case Stage::Sweeping:
+        m_deadlineTimer->stop();
+        m_pollTimer->stop();
+        startSweep();
+        break;
+    case Stage::Verifying:
+        startVerify();
+        break;
+    case Stage::Finished:
+        finish();
+        break;
+    case Stage::Idle:
+        break;
+    }
+}
+
+void AppStopper::onPoll()
+{
+    if (m_stage != Stage::Terminating && m_stage != Stage::Killing) {
+        return;
+    }
+
+    if (targetExited()) {
+        qDebug() << m_appName << (m_stage == Stage::Terminating ? "优雅停止成功" : "强制停止成功");
+        enterStage(Stage::Sweeping);
+    }
+}
+
+void AppStopper::onDeadline()
+{
+    switch (m_stage) {
+    case Stage::Terminating:
+        qWarning() << m_appName << "优雅终止超时，尝试强制杀死进程";
+        enterStage(Stage::Killing);
+        break;
+    case Stage::Killing:
+        qCritical() << m_appName << "进程可能已僵死，SIGKILL后仍未退出";
+        enterStage(Stage::Sweeping);
+        break;
+    case Stage::Verifying:
+        qWarning() << m_appName << "残留进程校验超时";
+        if (m_verifyProcess) {
+            m_verifyProcess->kill();
+        }
+        enterStage(Stage::Finished);
+        break;
+    default:
+        break;
+    }
+}
+
+void AppStopper::startSweep()
+{
+    if (m_plan.sweepPatterns.isEmpty()) {
+        enterStage(Stage::Verifying);
+        return;
+    }
+
+    // 所有pkill并发执行，全部结束后再进入校验阶段
+    m_pendingSweeps = m_plan.sweepPatterns.size();
+    for (const QString &pattern : m_plan.sweepPatterns) {
+        QProcess *sweep = new QProcess(this);
+        connect(sweep, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                this, &AppStopper::onSweepFinished);
+        connect(sweep, &QProcess::errorOccurred, this, [this, sweep](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+                qWarning() << "无法启动pkill:" << sweep->errorString();
+                onSweepFinished();
+            }
+        });
+        sweep->start("pkill", QStringList() << "-f" << pattern);
+    }
+}
+
+void AppStopper::onSweepFinished()
+{
+    QProcess *sweep = qobject_cast<QProcess*>(sender());
+    if (sweep) {
+        qDebug() << "pkill清理结果:" << sweep->arguments().value(1) << "(" << sweep->exitCode() << ")";
+        sweep->deleteLater();
+    }
+
+    if (--m_pendingSweeps > 0) {
+        return;
+    }
+
+    // 给进程留出退出时间后再校验
+    int settleDelay = m_forced ? m_plan.settleDelay * 2 : m_plan.settleDelay;
+    QTimer::singleShot(settleDelay, this, [this]() { enterStage(Stage::Verifying); });
+}
+
+void AppStopper::startVerify()
+{
+    if (m_plan.verifyPattern.isEmpty()) {
+        enterStage(Stage::Finished);
+        return;
+    }
+
+    m_verifyProcess = new QProcess(this);
+    connect(m_verifyProcess, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &AppStopper::onVerifyFinished);
+    connect(m_verifyProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            qWarning() << "无法启动pgrep，跳过残留进程校验";
+            enterStage(Stage::Finished);
+        }
+    });
+    m_verifyProcess->start("pgrep", QStringList() << "-f" << m_plan.verifyPattern);
+    m_deadlineTimer->start(m_plan.killTimeout);
+}
+
+void AppStopper::onVerifyFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    Q_UNUSED(exitCode)
+    Q_UNUSED(exitStatus)
+
+    if (m_stage != Stage::Verifying) {
+        return;
+    }
+    m_deadlineTimer->stop();
+
+    QByteArray output = m_verifyProcess->readAllStandardOutput();
+    if (output.trimmed().isEmpty()) {
+        qDebug() << "✅ 确认所有" << m_appName << "进程已完全停止";
+    } else {
+        qWarning() << "⚠️ 检测到残留的" << m_appName << "进程，PID:" << output.trimmed();
+        // 最后手段：直接发送SIGKILL，无需再创建子进程
+        const QList<QByteArray> pids = output.split('\n');
+        for (const QByteArray &pidText : pids) {
+            bool ok = false;
+            qint64 pid = pidText.trimmed().toLongLong(&ok);
+            if (ok && pid > 0) {
+                qDebug() << "强制杀死残留进程PID:" << pid;
+#ifdef Q_OS_UNIX
+                ::kill(static_cast<pid_t>(pid), SIGKILL);
+#endif
+            }
+        }
+    }
+
+    enterStage(Stage::Finished);
+}
+
+void AppStopper::finish()
+{
+    m_deadlineTimer->stop();
+    m_pollTimer->stop();
+    qDebug() << "🎉" << m_appName << (m_forced ? "强制停止流程完成" : "正常停止流程完成");
+    emit finished(m_appName, m_forced);
+    deleteLater();
+}
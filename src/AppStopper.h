@@ -0,0 +1,81 @@
+#ifndef APPSTOPPER_H
+#define APPSTOPPER_H
+
+#include <QObject>
+#include <QProcess>
+#include <QPointer>
+#include <QStringList>
+#include <QList>
+
+class QTimer;
+
+/**
+ * @brief 异步应用程序停止流程
+ *
+ * 基于单次定时器的状态机，全程不阻塞事件循环：
+ * 向进程组发送SIGTERM → 超时后升级为SIGKILL → 确认进程组已消失 → 发出finished信号
+ * 对于无法跟踪进程组的应用程序（终端分离启动），退化为pkill -f模式清理和pgrep校验
+ * 每个实例只执行一次停止流程，完成后自动释放
+ */
+class AppStopper : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 停止策略
+    struct Plan {
+        QList<qint64> processGroupIds; // 目标进程组（setsid启动的受管进程）
+        int pollInterval = 50;         // 检查进程组是否已退出的间隔（毫秒）
+        int terminateTimeout = 3000;   // SIGTERM后等待退出的时间（毫秒）
+        int killTimeout = 2000;        // SIGKILL后等待退出的时间（毫秒）
+        int settleDelay = 500;         // 清理后到校验前的等待时间（毫秒）
+        QStringList sweepPatterns;     // 需要pkill -f清理的进程模式
+        QString verifyPattern;         // 用pgrep -f校验残留进程的模式（为空则不校验）
+    };
+
+    enum class Stage {
+        Idle,
+        Terminating,   // 已向进程组发送SIGTERM
+        Killing,       // 已向进程组发送SIGKILL
+        Sweeping,      // 清理残留进程
+        Verifying,     // 校验进程是否已退出
+        Finished
+    };
+
+    AppStopper(const QString &appName, QProcess *process, const Plan &plan, QObject *parent = nullptr);
+
+    void start();
+
+    QString appName() const { return m_appName; }
+    Stage stage() const { return m_stage; }
+
+signals:
+    // 停止流程结束；forced表示进程未能响应SIGTERM而被强制结束
+    void finished(const QString &appName, bool forced);
+
+private slots:
+    void onPoll();
+    void onDeadline();
+    void onSweepFinished();
+    void onVerifyFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
+private:
+    void enterStage(Stage stage);
+    void signalTarget(bool force);
+    bool targetExited() const;
+    void startSweep();
+    void startVerify();
+    void finish();
+
+    QString m_appName;
+    QPointer<QProcess> m_process;
+    Plan m_plan;
+    Stage m_stage;
+    QTimer *m_deadlineTimer;
+    QTimer *m_pollTimer;
+    QProcess *m_verifyProcess;
+    int m_pendingSweeps;
+    bool m_forced;
+};
+
+#endif // APPSTOPPER_H
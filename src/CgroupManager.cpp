@@ -0,0 +1,148 @@
+#include "CgroupManager.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+namespace {
+    const char *CGROUP_MOUNT = "/sys/fs/cgroup";
+    const char *LAUNCHER_LEAF = "launcher";
+
+    // 控制器列表形如"cpuset cpu io memory pids"
+    bool hasCpuAndMemory(const QByteArray &controllers)
+    {
+        const QList<QByteArray> names = controllers.trimmed().split(' ');
+        return names.contains("cpu") && names.contains("memory");
+    }
+}
+
+CgroupManager::CgroupManager(QObject *parent)
+    : QObject(parent)
+    , m_prepared(false)
+    , m_available(false)
+{
+}
+
+CgroupManager::~CgroupManager()
+{
+    // 应用程序已全部停止时子组为空，可以删除
+    for (const QString &appId : m_groups) {
+        QDir().rmdir(groupPath(appId));
+    }
+}
+
+QByteArray CgroupManager::readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    // cgroup文件的大小为0，需要一次读到EOF
+    return file.readAll();
+}
+
+bool CgroupManager::writeFile(const QString &path, const QByteArray &data, QString *error)
+{
+    // 内核在write()时校验内容，不缓冲才能拿到真实的错误
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Unbuffered) || file.write(data) != data.size()) {
+        *error = QString("%1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QString CgroupManager::groupPath(const QString &appId) const
+{
+    return QString("%1/app-%2").arg(m_root, appId);
+}
+
+bool CgroupManager::prepare()
+{
+    if (m_prepared) {
+        return m_available;
+    }
+    m_prepared = true;
+
+#ifdef Q_OS_LINUX
+    // cgroup v2统一层级中/proc/self/cgroup只有一行"0::<路径>"
+    QString relativePath;
+    const QList<QByteArray> lines = readFile("/proc/self/cgroup").split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("0::")) {
+            relativePath = QString::fromLocal8Bit(line.mid(3));
+        }
+    }
+    if (relativePath.isEmpty() || !QFileInfo::exists(QString("%1/cgroup.controllers").arg(CGROUP_MOUNT))) {
+        qWarning() << "未使用cgroup v2，忽略cpuMax/memoryMax限制";
+        return false;
+    }
+    m_root = QDir::cleanPath(QString(CGROUP_MOUNT) + relativePath);
+
+    const QByteArray controllers = readFile(m_root + "/cgroup.controllers");
+    if (!hasCpuAndMemory(controllers)) {
+        qWarning() << "cgroup" << m_root << "未委派cpu/memory控制器，忽略cpuMax/memoryMax限制";
+        return false;
+    }
+
+    QString error;
+    const QByteArray subtreeControl = readFile(m_root + "/cgroup.subtree_control");
+    if (!hasCpuAndMemory(subtreeControl)) {
+        // 有进程的组不能启用控制器：把组内所有进程（包括启动器自身）移入叶子组
+        QString leaf = QString("%1/%2").arg(m_root, LAUNCHER_LEAF);
+        if (!QDir().mkpath(leaf)) {
+            qWarning() << "无法创建cgroup" << leaf << "，忽略cpuMax/memoryMax限制";
+            return false;
+        }
+        const QList<QByteArray> pids = readFile(m_root + "/cgroup.procs").split('\n');
+        for (const QByteArray &pid : pids) {
+            if (!pid.isEmpty() && !writeFile(leaf + "/cgroup.procs", pid, &error)) {
+                qDebug() << "移动进程失败（可能已退出）:" << error;
+            }
+        }
+        if (!writeFile(m_root + "/cgroup.subtree_control", "+cpu +memory", &error)) {
+            qWarning() << "无法启用cgroup控制器，忽略cpuMax/memoryMax限制:" << error;
+            return false;
+        }
+    }
+
+    qDebug() << "应用程序cgroup位于" << m_root;
+    m_available = true;
+#endif
+    return m_available;
+}
+
+QByteArray CgroupManager::applicationGroup(const QString &appId, int cpuMaxPercent, qint64 memoryMax)
+{
+    if (!prepare()) {
+        return QByteArray();
+    }
+
+    QString path = groupPath(appId);
+    if (!QDir().mkpath(path)) {
+        qWarning() << "无法创建cgroup" << path;
+        return QByteArray();
+    }
+    m_groups.insert(appId);
+
+    // 每次启动都重新写入，配置修改后无需手动清理旧的组
+    QByteArray cpuMax = cpuMaxPercent > 0
+            ? QByteArray::number(static_cast<qint64>(cpuMaxPercent) * CPU_PERIOD / 100) + " " + QByteArray::number(CPU_PERIOD)
+            : QByteArray("max");
+    QByteArray memory = memoryMax > 0 ? QByteArray::number(memoryMax) : QByteArray("max");
+    QString error;
+    if (!writeFile(path + "/cpu.max", cpuMax, &error) || !writeFile(path + "/memory.max", memory, &error)) {
+        qWarning() << "写入" << appId << "的cgroup限制失败:" << error;
+        return QByteArray();
+    }
+
+    qDebug() << appId << "cgroup限制: cpu.max =" << cpuMax << "memory.max =" << memory;
+    return QFile::encodeName(path + "/cgroup.procs");
+}
+
+void CgroupManager::releaseApplicationGroup(const QString &appId)
+{
+    if (m_groups.contains(appId) && QDir().rmdir(groupPath(appId))) {
+        m_groups.remove(appId);
+    }
+}
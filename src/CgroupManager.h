@@ -0,0 +1,46 @@
+#ifndef CGROUPMANAGER_H
+#define CGROUPMANAGER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+
+/**
+ * @brief 启动器所属的cgroup v2子树
+ *
+ * 在启动器自身的cgroup下为每个应用程序创建子组（app-<id>）并写入cpu.max/memory.max。
+ * cgroup v2不允许有进程的组再启用控制器，因此首次需要时先把组内已有进程
+ * （启动器，以及从终端启动时的shell）移入叶子组"launcher"，再启用cpu和memory控制器。
+ * 需要systemd委派这两个控制器（用户会话默认委派）；不可用时只记录警告，不影响启动
+ */
+class CgroupManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CgroupManager(QObject *parent = nullptr);
+    ~CgroupManager();
+
+    // 创建或更新应用程序的子组，返回子进程要写入的cgroup.procs路径；失败时返回空
+    // cpuMaxPercent：100表示一个核心，0表示不限制；memoryMax：字节，0表示不限制
+    QByteArray applicationGroup(const QString &appId, int cpuMaxPercent, qint64 memoryMax);
+
+    // 应用程序停止后删除其子组（仍有残留进程时保留）
+    void releaseApplicationGroup(const QString &appId);
+
+    static constexpr int CPU_PERIOD = 100000;   // cpu.max的周期（微秒）
+
+private:
+    bool prepare();
+    QString groupPath(const QString &appId) const;
+    static QByteArray readFile(const QString &path);
+    static bool writeFile(const QString &path, const QByteArray &data, QString *error);
+
+    QString m_root;              // 启动器所在的cgroup目录
+    QSet<QString> m_groups;      // 已创建的子组
+    bool m_prepared;
+    bool m_available;
+};
+
+#endif // CGROUPMANAGER_H
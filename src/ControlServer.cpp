@@ -0,0 +1,218 @@
+#include "ControlServer.h"
+#include "Supervisor.h"
+#include "qt_compatibility.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+    QJsonObject failure(const QString &message)
+    {
+        QJsonObject reply;
+        reply.insert("ok", false);
+        reply.insert("error", message);
+        return reply;
+    }
+
+    QString runtimeDirectory()
+    {
+        QString directory = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+        return directory.isEmpty() ? QDir::tempPath() : directory;
+    }
+
+    QString instanceName(ControlServer::Instance instance)
+    {
+        return instance == ControlServer::Instance::Daemon ? "flight_controls_supervisord" : "flight_controls_launcher";
+    }
+
+    QByteArray encode(const QJsonObject &reply)
+    {
+        return QJsonDocument(reply).toJson(QJsonDocument::Compact) + "\n";
+    }
+}
+
+ControlServer::ControlServer(Supervisor *supervisor, Instance instance, QObject *parent)
+    : QObject(parent)
+    , m_server(nullptr)
+    , m_supervisor(supervisor)
+    , m_instance(instance)
+    , m_statusTimer(nullptr)
+{
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+
+    // 状态推送：只在有watch连接时发送
+    m_statusTimer = new QTimer(this);
+    m_statusTimer->setSingleShot(true);
+    m_statusTimer->setInterval(0);
+    connect(m_statusTimer, &QTimer::timeout, this, &ControlServer::publishStatus);
+    connect(m_supervisor, &Supervisor::stateChanged, this, [this]() {
+        if (!m_watchers.isEmpty()) {
+            m_statusTimer->start();
+        }
+    });
+    connect(m_supervisor, &Supervisor::launchFailed, this, [this](int index, const QString &message) {
+        QJsonObject event;
+        event.insert("event", "launchFailed");
+        event.insert("id", m_supervisor->definition(index).id);
+        event.insert("message", message);
+        publish(event);
+    });
+    connect(m_supervisor, &Supervisor::restartAbandoned, this, [this](int index, const QString &reason) {
+        QJsonObject event;
+        event.insert("event", "restartAbandoned");
+        event.insert("id", m_supervisor->definition(index).id);
+        event.insert("reason", reason);
+        publish(event);
+    });
+}
+
+QString ControlServer::socketPath(Instance instance)
+{
+    return runtimeDirectory() + "/" + instanceName(instance) + ".sock";
+}
+
+QString ControlServer::lockPath(Instance instance)
+{
+    return runtimeDirectory() + "/" + instanceName(instance) + ".lock";
+}
+
+bool ControlServer::listen(QString *error)
+{
+    // 调用方已持有单实例锁，残留的套接字文件只可能来自崩溃的旧实例
+    const QString path = socketPath(m_instance);
+    QLocalServer::removeServer(path);
+    if (!m_server->listen(path)) {
+        *error = m_server->errorString();
+        return false;
+    }
+    qDebug() << "控制套接字:" << m_server->fullServerName();
+    return true;
+}
+
+void ControlServer::onNewConnection()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() { m_watchers.removeAll(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+    }
+}
+
+void ControlServer::onReadyRead(QLocalSocket *socket)
+{
+    while (socket->canReadLine()) {
+        QString line = QString::fromUtf8(socket->readLine()).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+        socket->write(encode(execute(line, socket)));
+    }
+    // 不含换行的超长输入不是合法命令
+    if (socket->bytesAvailable() > MAX_COMMAND_LENGTH) {
+        socket->write(encode(failure("命令过长")));
+        socket->disconnectFromServer();
+    }
+}
+
+QJsonObject ControlServer::execute(const QString &line, QLocalSocket *socket)
+{
+    const QStringList words = QtCompat::splitSkipEmpty(line, ' ');
+    const QString command = words.first();
+    const QString argument = words.value(1);
+    qDebug() << "控制命令:" << line;
+
+    QJsonObject reply;
+    if (command == "show") {
+        if (receivers(SIGNAL(showRequested())) == 0) {
+            return failure("无界面运行，无法显示窗口");
+        }
+        emit showRequested();
+    } else if (command == "start" && !argument.isEmpty()) {
+        if (!m_supervisor->startApplication(argument)) {
+            return failure(QString("未定义的应用程序: %1").arg(argument));
+        }
+    } else if (command == "stop" && !argument.isEmpty()) {
+        if (!m_supervisor->stopApplication(argument)) {
+            return failure(QString("未定义的应用程序: %1").arg(argument));
+        }
+    } else if (command == "stop-all") {
+        m_supervisor->stopAllApplications();
+    } else if (command == "profile" && !argument.isEmpty()) {
+        if (!m_supervisor->startProfile(argument)) {
+            return failure(QString("未定义的启动配置: %1").arg(argument));
+        }
+    } else if (command == "status") {
+        reply = m_supervisor->statusReport();
+    } else if (command == "watch") {
+        if (!m_watchers.contains(socket)) {
+            m_watchers.append(socket);
+        }
+        reply = m_supervisor->statusReport();
+        reply.insert("event", "status");
+    } else if (command == "help") {
+        reply.insert("commands", QJsonArray::fromStringList(QStringList()
+                     << "show" << "start <id>" << "stop <id>" << "stop-all" << "profile <id>" << "status" << "watch"));
+    } else {
+        return failure(QString("无法识别的命令: %1（help查看可用命令）").arg(line));
+    }
+
+    reply.insert("ok", true);
+    return reply;
+}
+
+void ControlServer::publish(QJsonObject event)
+{
+    event.insert("ok", true);
+    const QByteArray line = encode(event);
+    for (QLocalSocket *socket : m_watchers) {
+        socket->write(line);
+    }
+}
+
+void ControlServer::publishStatus()
+{
+    QJsonObject event = m_supervisor->statusReport();
+    event.insert("event", "status");
+    publish(event);
+}
+
+bool ControlServer::send(Instance instance, const QStringList &commands, QStringList *replies, QString *error)
+{
+    // 持有锁的实例刚启动时可能还没有开始监听，短暂重试
+    const QString path = socketPath(instance);
+    QLocalSocket socket;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    socket.connectToServer(path);
+    while (!socket.waitForConnected(100)) {
+        if (elapsed.elapsed() >= CONNECT_TIMEOUT) {
+            *error = QString("无法连接到运行中的实例: %1").arg(socket.errorString());
+            return false;
+        }
+        QThread::msleep(50);
+        socket.connectToServer(path);
+    }
+
+    for (const QString &command : commands) {
+        socket.write(command.toUtf8() + "\n");
+        socket.flush();
+        while (!socket.canReadLine()) {
+            if (!socket.waitForReadyRead(REPLY_TIMEOUT)) {
+                *error = QString("等待回复超时: %1").arg(command);
+                return false;
+            }
+        }
+        replies->append(QString::fromUtf8(socket.readLine()).trimmed());
+    }
+    socket.disconnectFromServer();
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+class QLocalServer;
+class QLocalSocket;
+class QTimer;
+class Supervisor;
+
+/**
+ * @brief 启动器的本地控制套接字（单实例和脚本控制）
+ *
+ * 浮动启动器和flight_controls_supervisord各有自己的锁和套接字（运行时目录$XDG_RUNTIME_DIR中的
+ * flight_controls_launcher.*和flight_controls_supervisord.*）。守护进程运行时，浮动启动器通过watch
+ * 订阅守护进程的状态并把控制命令转发给它，只在本地负责窗口管理；没有守护进程时浮动启动器持有
+ * 守护进程的锁并自己监管应用程序，此时守护进程无法启动。
+ * 第二次运行启动器时不再创建窗口，而是把命令转发给运行中的启动器后立即退出。
+ * 协议为按行的文本命令，每条命令回复一行JSON（{"ok":true,...}或{"ok":false,"error":...}）：
+ *   show | start <id> | stop <id> | stop-all | profile <id> | status | watch | help
+ * watch立即回复一次status事件（{"ok":true,"event":"status",...}），之后该连接在状态变化时收到status事件，
+ * 启动失败和放弃自动重启时收到launchFailed和restartAbandoned事件。
+ * 例如：echo status | socat - UNIX-CONNECT:$XDG_RUNTIME_DIR/flight_controls_launcher.sock
+ */
+class ControlServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Instance {
+        Launcher,   // 浮动启动器
+        Daemon      // flight_controls_supervisord
+    };
+
+    ControlServer(Supervisor *supervisor, Instance instance, QObject *parent = nullptr);
+
+    bool listen(QString *error);
+
+    static QString socketPath(Instance instance);
+    static QString lockPath(Instance instance);     // 单实例锁（QLockFile），持有者负责监听socketPath(instance)
+
+    // 客户端：依次发送命令并返回每条回复；连接失败或超时时返回false
+    static bool send(Instance instance, const QStringList &commands, QStringList *replies, QString *error);
+
+    static constexpr int CONNECT_TIMEOUT = 3000;   // 运行中的实例可能尚未开始监听（毫秒）
+    static constexpr int REPLY_TIMEOUT = 5000;     // 毫秒
+    static constexpr int MAX_COMMAND_LENGTH = 1024;
+
+signals:
+    void showRequested();   // 没有连接时（无界面运行）show命令返回错误
+
+private slots:
+    void onNewConnection();
+
+private:
+    void onReadyRead(QLocalSocket *socket);
+    QJsonObject execute(const QString &line, QLocalSocket *socket);
+    void publish(QJsonObject event);   // 发给所有watch连接
+    void publishStatus();
+
+    QLocalServer *m_server;
+    Supervisor *m_supervisor;
+    Instance m_instance;
+    QList<QLocalSocket *> m_watchers;
+    QTimer *m_statusTimer;              // 合并同一轮事件循环中的多次状态变化
+};
+
+#endif // CONTROLSERVER_H
@@ -0,0 +1,92 @@
+#include "DaemonConnection.h"
+#include "ControlServer.h"
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QLocalSocket>
+#include <QThread>
+#include <QDebug>
+
+DaemonConnection::DaemonConnection(QObject *parent)
+    : QObject(parent)
+    , m_socket(nullptr)
+{
+    m_socket = new QLocalSocket(this);
+}
+
+bool DaemonConnection::open(const QString &socketPath, QString *error)
+{
+    // 守护进程刚启动时可能还没有开始监听，短暂重试
+    QElapsedTimer elapsed;
+    elapsed.start();
+    m_socket->connectToServer(socketPath);
+    while (!m_socket->waitForConnected(100)) {
+        if (elapsed.elapsed() >= ControlServer::CONNECT_TIMEOUT) {
+            *error = QString("无法连接到监管守护进程: %1").arg(m_socket->errorString());
+            return false;
+        }
+        QThread::msleep(50);
+        m_socket->connectToServer(socketPath);
+    }
+
+    m_socket->write("watch\n");
+    m_socket->flush();
+    while (!m_socket->canReadLine()) {
+        if (!m_socket->waitForReadyRead(ControlServer::REPLY_TIMEOUT)) {
+            *error = "等待监管守护进程的状态超时";
+            m_socket->abort();
+            return false;
+        }
+    }
+    const QByteArray line = m_socket->readLine();
+    if (QJsonDocument::fromJson(line).object().value("event").toString() != "status") {
+        *error = QString("监管守护进程不支持状态订阅: %1").arg(QString::fromUtf8(line).trimmed());
+        m_socket->abort();
+        return false;
+    }
+    handleLine(line);
+
+    // 之后的回复和推送由事件循环处理
+    connect(m_socket, &QLocalSocket::readyRead, this, &DaemonConnection::onReadyRead);
+    connect(m_socket, &QLocalSocket::disconnected, this, &DaemonConnection::disconnected);
+    onReadyRead();
+    return true;
+}
+
+bool DaemonConnection::isConnected() const
+{
+    return m_socket->state() == QLocalSocket::ConnectedState;
+}
+
+void DaemonConnection::send(const QString &command)
+{
+    if (!isConnected()) {
+        qWarning() << "监管守护进程未连接，忽略命令:" << command;
+        return;
+    }
+    qDebug() << "转发给监管守护进程:" << command;
+    m_socket->write(command.toUtf8() + "\n");
+}
+
+void DaemonConnection::onReadyRead()
+{
+    while (m_socket->canReadLine()) {
+        handleLine(m_socket->readLine());
+    }
+}
+
+void DaemonConnection::handleLine(const QByteArray &line)
+{
+    const QJsonObject reply = QJsonDocument::fromJson(line).object();
+    if (!reply.value("ok").toBool()) {
+        qWarning() << "监管守护进程拒绝了命令:" << reply.value("error").toString();
+        return;
+    }
+
+    const QString event = reply.value("event").toString();
+    if (event == "status") {
+        emit statusReceived(reply);
+    } else if (!event.isEmpty()) {
+        emit eventReceived(reply);
+    }
+    // 其余为普通命令的成功回复
+}
@@ -0,0 +1,41 @@
+#ifndef DAEMONCONNECTION_H
+#define DAEMONCONNECTION_H
+
+#include <QObject>
+#include <QJsonObject>
+
+class QLocalSocket;
+
+/**
+ * @brief 到flight_controls_supervisord控制套接字的常驻连接（浮动启动器的委托模式）
+ *
+ * 连接后发送watch订阅状态：守护进程在状态变化时推送status事件，启动失败和放弃自动重启时推送对应事件。
+ * 控制命令异步发送，命令的回复与推送在同一连接上按行到达，失败的回复只记录警告
+ */
+class DaemonConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DaemonConnection(QObject *parent = nullptr);
+
+    // 连接、订阅并等待第一份状态（阻塞，启动时调用一次）
+    bool open(const QString &socketPath, QString *error);
+    bool isConnected() const;
+    void send(const QString &command);
+
+signals:
+    void statusReceived(const QJsonObject &status);
+    void eventReceived(const QJsonObject &event);   // launchFailed、restartAbandoned
+    void disconnected();
+
+private slots:
+    void onReadyRead();
+
+private:
+    void handleLine(const QByteArray &line);
+
+    QLocalSocket *m_socket;
+};
+
+#endif // DAEMONCONNECTION_H
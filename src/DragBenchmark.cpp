@@ -0,0 +1,164 @@
+#include "DragBenchmark.h"
+#include <QApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+#include <QScreen>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+#include <QDebug>
+#include <cmath>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+DragBenchmark::DragBenchmark(QWidget *widget, const QString &mode, const QString &outputPath)
+    : QObject(widget)
+    , m_widget(widget)
+    , m_mode(mode)
+    , m_outputPath(outputPath)
+    , m_motionTimer(nullptr)
+    , m_frameTimer(nullptr)
+    , m_frameInterval(16)
+    , m_cpuStart(0)
+    , m_motionEvents(0)
+    , m_moves(0)
+    , m_paints(0)
+    , m_frames(0)
+    , m_droppedFrames(0)
+{
+    m_motionTimer = new QTimer(this);
+    m_motionTimer->setTimerType(Qt::PreciseTimer);
+    m_motionTimer->setInterval(1000 / MOTION_RATE);
+    connect(m_motionTimer, &QTimer::timeout, this, &DragBenchmark::sendMotion);
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout, this, &DragBenchmark::onFrameTick);
+}
+
+void DragBenchmark::start(QWidget *widget, const QString &mode, const QString &outputPath)
+{
+    // 对象随窗口销毁
+    DragBenchmark *benchmark = new DragBenchmark(widget, mode, outputPath);
+    QTimer::singleShot(START_DELAY, benchmark, &DragBenchmark::begin);
+}
+
+void DragBenchmark::begin()
+{
+    QScreen *screen = m_widget->windowHandle() ? m_widget->windowHandle()->screen() : QApplication::primaryScreen();
+    qreal refreshRate = screen ? screen->refreshRate() : 0;
+    m_frameInterval = qMax(1, qRound(1000.0 / (refreshRate > 0 ? refreshRate : 60.0)));
+
+    // 在窗口顶部边缘（背景区域）按下，避开按钮
+    m_pressPosition = m_widget->mapToGlobal(QPoint(m_widget->width() / 2, 4));
+    m_widget->installEventFilter(this);
+    sendMouseEvent(QEvent::MouseButtonPress, m_pressPosition);
+
+    m_cpuStart = cpuTimeUs();
+    m_elapsed.start();
+    m_lastTick.start();
+    m_motionTimer->start();
+    m_frameTimer->start(m_frameInterval);
+}
+
+QPoint DragBenchmark::pointerAt(qint64 elapsedMs) const
+{
+    // 沿圆周移动一圈，起点为按下位置
+    const double pi = 3.14159265358979323846;
+    const double angle = 2 * pi * elapsedMs / DURATION;
+    return m_pressPosition + QPoint(qRound(RADIUS * std::sin(angle)), qRound(RADIUS * (1 - std::cos(angle))));
+}
+
+void DragBenchmark::sendMotion()
+{
+    // 事件循环被阻塞时鼠标事件会在X队列中堆积，这里按时间补发以模拟同样的突发
+    qint64 elapsed = qMin<qint64>(m_elapsed.elapsed(), DURATION);
+    qint64 due = elapsed * MOTION_RATE / 1000;
+    while (m_motionEvents < due) {
+        ++m_motionEvents;
+        sendMouseEvent(QEvent::MouseMove, pointerAt(m_motionEvents * 1000 / MOTION_RATE));
+    }
+    if (elapsed >= DURATION) {
+        finish();
+    }
+}
+
+void DragBenchmark::onFrameTick()
+{
+    // 每个周期应触发一次，间隔达到两个周期以上说明事件循环错过了帧
+    qint64 interval = m_lastTick.restart();
+    int missed = static_cast<int>(interval / m_frameInterval) - 1;
+    if (missed > 0) {
+        m_droppedFrames += missed;
+    }
+    ++m_frames;
+}
+
+void DragBenchmark::sendMouseEvent(int type, const QPoint &globalPos)
+{
+    QPoint localPos = globalPos - m_widget->geometry().topLeft();
+    Qt::MouseButton button = (type == QEvent::MouseMove) ? Qt::NoButton : Qt::LeftButton;
+    Qt::MouseButtons buttons = (type == QEvent::MouseButtonRelease) ? Qt::NoButton : Qt::LeftButton;
+    QMouseEvent event(static_cast<QEvent::Type>(type), localPos, localPos, globalPos, button, buttons, Qt::NoModifier);
+    QCoreApplication::sendEvent(m_widget, &event);
+}
+
+bool DragBenchmark::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_widget) {
+        if (event->type() == QEvent::Move) {
+            ++m_moves;
+        } else if (event->type() == QEvent::Paint) {
+            ++m_paints;
+        }
+    }
+    return false;
+}
+
+void DragBenchmark::finish()
+{
+    m_motionTimer->stop();
+    m_frameTimer->stop();
+    sendMouseEvent(QEvent::MouseButtonRelease, pointerAt(DURATION));
+    m_widget->removeEventFilter(this);
+
+    qint64 wallMs = m_elapsed.elapsed();
+    qint64 cpuUs = cpuTimeUs() - m_cpuStart;
+
+    QJsonObject result;
+    result.insert("mode", m_mode);
+    result.insert("duration_ms", wallMs);
+    result.insert("frame_interval_ms", m_frameInterval);
+    result.insert("motion_events", m_motionEvents);
+    result.insert("window_moves", m_moves);
+    result.insert("paints", m_paints);
+    result.insert("frames", m_frames);
+    result.insert("dropped_frames", m_droppedFrames);
+    result.insert("cpu_ms", cpuUs / 1000.0);
+    result.insert("cpu_percent", wallMs > 0 ? cpuUs / 10.0 / wallMs : 0.0);
+
+    QFile file(m_outputPath);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(QJsonDocument(result).toJson(QJsonDocument::Compact) + "\n");
+        qDebug() << "拖动基准测试结果已写入:" << m_outputPath;
+    } else {
+        qWarning() << "无法写入拖动基准测试结果:" << m_outputPath;
+    }
+    QCoreApplication::quit();
+}
+
+qint64 DragBenchmark::cpuTimeUs()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000LL
+                + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef DRAGBENCHMARK_H
+#define DRAGBENCHMARK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QPoint>
+#include <QString>
+
+class QTimer;
+class QWidget;
+
+/**
+ * @brief 拖动性能基准测试（--benchmark-drag）
+ *
+ * 窗口显示后向其发送合成的鼠标按下、移动（1000Hz，沿圆周）和释放事件，
+ * 同时以屏幕刷新周期运行帧时钟：事件循环被移动和重绘阻塞而错过的时钟周期计为丢帧。
+ * 结束后把丢帧数、窗口移动次数、重绘次数和进程CPU时间以一行JSON写入文件并退出事件循环。
+ * 合成事件不经过窗口管理器，因此只比较coalesced和immediate两种方式
+ */
+class DragBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int START_DELAY = 500;       // 等待窗口映射和首帧（毫秒）
+    static constexpr int DURATION = 3000;         // 拖动时长（毫秒）
+    static constexpr int MOTION_RATE = 1000;      // 每秒移动事件数（常见游戏鼠标的回报率）
+    static constexpr int RADIUS = 200;            // 圆周半径（像素）
+
+    // mode只用于写入结果
+    static void start(QWidget *widget, const QString &mode, const QString &outputPath);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    DragBenchmark(QWidget *widget, const QString &mode, const QString &outputPath);
+
+    void begin();
+    void sendMotion();      // 补发到当前时刻为止应到达的移动事件
+    void onFrameTick();
+    void finish();
+    void sendMouseEvent(int type, const QPoint &globalPos);
+    QPoint pointerAt(qint64 elapsedMs) const;
+    static qint64 cpuTimeUs();
+
+    QWidget *m_widget;
+    QString m_mode;
+    QString m_outputPath;
+    QTimer *m_motionTimer;
+    QTimer *m_frameTimer;
+    QElapsedTimer m_elapsed;
+    QElapsedTimer m_lastTick;
+    QPoint m_pressPosition;
+    int m_frameInterval;
+    qint64 m_cpuStart;
+    int m_motionEvents;
+    int m_moves;
+    int m_paints;
+    int m_frames;
+    int m_droppedFrames;
+};
+
+#endif // DRAGBENCHMARK_H
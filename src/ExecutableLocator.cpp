@@ -0,0 +1,206 @@
+#include "ExecutableLocator.h"
+#include "qt_compatibility.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace {
+    struct FileIdentity {
+        qint64 inode = 0;
+        qint64 mtimeNs = 0;
+        bool valid = false;
+    };
+
+    // 与缓存记录比较的文件身份：被替换（新inode）或原地改写（新mtime）都会使其失效
+    FileIdentity fileIdentity(const QString &path)
+    {
+        FileIdentity identity;
+#ifdef Q_OS_UNIX
+        struct stat st;
+        if (::stat(QFile::encodeName(path).constData(), &st) == 0
+                && S_ISREG(st.st_mode) && (st.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH))) {
+            identity.inode = static_cast<qint64>(st.st_ino);
+            identity.mtimeNs = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+            identity.valid = true;
+        }
+#else
+        QFileInfo info(path);
+        if (info.isFile() && info.isExecutable()) {
+            identity.mtimeNs = info.lastModified().toMSecsSinceEpoch() * 1000000LL;
+            identity.valid = true;
+        }
+#endif
+        return identity;
+    }
+}
+
+ExecutableLocator::ExecutableLocator(const QString &cacheKey, const QStringList &candidates, QObject *parent)
+    : QObject(parent)
+    , m_cacheKey(cacheKey)
+    , m_candidates(candidates)
+    , m_valid(false)
+    , m_cacheLoaded(false)
+    , m_watcher(nullptr)
+{
+}
+
+QString ExecutableLocator::cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/executable_cache.json";
+}
+
+QStringList ExecutableLocator::candidatesFromEnvironment(const char *variable)
+{
+    return QtCompat::splitSkipEmpty(QString::fromLocal8Bit(qgetenv(variable)), ':');
+}
+
+QString ExecutableLocator::resolve()
+{
+    // 热路径：文件系统没有变化时直接返回
+    if (m_valid) {
+        return m_resolvedPath;
+    }
+
+    // 本次运行首次解析：先尝试持久化缓存（一次stat）
+    bool fromCache = !m_cacheLoaded && loadCachedPath();
+    m_cacheLoaded = true;
+
+    if (!fromCache) {
+        m_resolvedPath = probeCandidates();
+        saveCachedPath();
+    }
+
+    m_valid = true;
+    watchCandidates();
+
+    if (m_resolvedPath.isEmpty()) {
+        qWarning() << m_cacheKey << "在候选路径中均未找到:" << m_candidates;
+    } else {
+        qDebug() << "找到" << m_cacheKey << ":" << m_resolvedPath << (fromCache ? "（缓存）" : "");
+    }
+    return m_resolvedPath;
+}
+
+void ExecutableLocator::invalidate()
+{
+    if (m_valid) {
+        qDebug() << m_cacheKey << "候选目录发生变化，下次启动时重新查找";
+    }
+    m_valid = false;
+}
+
+QString ExecutableLocator::probeCandidates() const
+{
+    for (const QString &path : m_candidates) {
+        QFileInfo fileInfo(path);
+        if (fileInfo.exists() && fileInfo.isExecutable()) {
+            return fileInfo.absoluteFilePath();
+        }
+    }
+    return QString();
+}
+
+bool ExecutableLocator::loadCachedPath()
+{
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject entry = QJsonDocument::fromJson(file.readAll()).object().value(m_cacheKey).toObject();
+    const QString path = entry.value("path").toString();
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    // 候选路径配置变化后旧的结果不再可信
+    if (entry.value("candidates").toString() != m_candidates.join(':')) {
+        return false;
+    }
+
+    FileIdentity identity = fileIdentity(path);
+    if (!identity.valid
+            || QString::number(identity.inode) != entry.value("inode").toString()
+            || QString::number(identity.mtimeNs) != entry.value("mtime").toString()) {
+        qDebug() << m_cacheKey << "路径缓存已失效:" << path;
+        return false;
+    }
+
+    m_resolvedPath = path;
+    return true;
+}
+
+void ExecutableLocator::saveCachedPath() const
+{
+    QJsonObject root;
+    QFile existing(cachePath());
+    if (existing.open(QIODevice::ReadOnly)) {
+        root = QJsonDocument::fromJson(existing.readAll()).object();
+        existing.close();
+    }
+
+    FileIdentity identity = fileIdentity(m_resolvedPath);
+    if (m_resolvedPath.isEmpty() || !identity.valid) {
+        root.remove(m_cacheKey);
+    } else {
+        // 64位整数以字符串保存，避免JSON双精度丢失
+        QJsonObject entry;
+        entry.insert("path", m_resolvedPath);
+        entry.insert("inode", QString::number(identity.inode));
+        entry.insert("mtime", QString::number(identity.mtimeNs));
+        entry.insert("candidates", m_candidates.join(':'));
+        root.insert(m_cacheKey, entry);
+    }
+
+    QSaveFile file(cachePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "无法写入路径缓存:" << cachePath();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void ExecutableLocator::watchCandidates()
+{
+    if (!m_watcher) {
+        m_watcher = new QFileSystemWatcher(this);
+        connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &ExecutableLocator::invalidate);
+        connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &ExecutableLocator::invalidate);
+    }
+
+    // 监视所有存在的候选目录（新文件出现或被替换）以及当前结果本身（原地改写）
+    QStringList paths;
+    for (const QString &candidate : m_candidates) {
+        QString dir = QFileInfo(candidate).absolutePath();
+        if (!paths.contains(dir) && QFileInfo(dir).isDir()) {
+            paths << dir;
+        }
+    }
+    if (!m_resolvedPath.isEmpty()) {
+        paths << m_resolvedPath;
+    }
+
+    // 被替换的文件会从监视列表中移除，每次重新解析后补上
+    QStringList missing;
+    const QStringList watched = m_watcher->files() + m_watcher->directories();
+    for (const QString &path : paths) {
+        if (!watched.contains(path)) {
+            missing << path;
+        }
+    }
+    if (!missing.isEmpty()) {
+        m_watcher->addPaths(missing);
+    }
+}
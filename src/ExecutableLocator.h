@@ -0,0 +1,52 @@
+#ifndef EXECUTABLELOCATOR_H
+#define EXECUTABLELOCATOR_H
+
+#include <QObject>
+#include <QStringList>
+
+class QFileSystemWatcher;
+
+/**
+ * @brief 可执行文件路径解析缓存
+ *
+ * 按顺序在候选路径中查找可执行文件，结果连同inode和修改时间保存在
+ * AppDataLocation/executable_cache.json中；下次启动时只需一次stat即可确认缓存仍然有效。
+ * 首次解析后用QFileSystemWatcher监视各候选目录，目录内容变化（例如QGC升级）时
+ * 立即使缓存失效，其余时候点击启动不再逐个探测文件系统
+ */
+class ExecutableLocator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // cacheKey用于区分缓存文件中的不同程序；candidates为按优先级排列的完整文件路径
+    ExecutableLocator(const QString &cacheKey, const QStringList &candidates, QObject *parent = nullptr);
+
+    // 返回可执行文件的绝对路径，未找到时为空
+    QString resolve();
+
+    QStringList candidates() const { return m_candidates; }
+
+    // 从环境变量读取额外的候选路径（以冒号分隔，优先于内置路径）
+    static QStringList candidatesFromEnvironment(const char *variable);
+
+    static QString cachePath();
+
+private slots:
+    void invalidate();
+
+private:
+    QString probeCandidates() const;
+    bool loadCachedPath();
+    void saveCachedPath() const;
+    void watchCandidates();
+
+    QString m_cacheKey;
+    QStringList m_candidates;
+    QString m_resolvedPath;
+    bool m_valid;          // 内存中的结果在上次文件系统变化之后仍然有效
+    bool m_cacheLoaded;    // 已尝试过读取持久化缓存
+    QFileSystemWatcher *m_watcher;
+};
+
+#endif // EXECUTABLELOCATOR_H
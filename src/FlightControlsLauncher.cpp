@@ -1,171 +1,123 @@
 #include "FlightControlsLauncher.h"
+#include "Supervisor.h"
+#include "X11WindowWatcher.h"
+#include "X11Service.h"
+#include "StartupTrace.h"
+#include "LaunchTimeline.h"
+#include "ResourceMonitor.h"
+#include <QStandardPaths>
 #include <QApplication>
 #include <QScreen>
+#include <QWindow>
 #include <QMessageBox>
 #include <QDebug>
 #include <QFont>
-#include <QGraphicsDropShadowEffect>
-#include <QFileInfo>
+#include <QColor>
+#include <QGraphicsBlurEffect>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEvent>
 #include <QDir>
-#include <algorithm>  // 用于std::sort
+#include <QMenu>
+#include <QContextMenuEvent>
+#include <QDateTime>
 
-// 在包含X11头文件之前，需要解决宏冲突
-#ifdef Q_OS_LINUX
-// 保存Qt可能使用的宏
-#ifdef Bool
-#define QT_X11_Bool Bool
-#undef Bool
-#endif
-
-#ifdef Status
-#define QT_X11_Status Status
-#undef Status
-#endif
-
-#ifdef Unsorted
-#define QT_X11_Unsorted Unsorted
-#undef Unsorted
-#endif
-
-#ifdef None
-#define QT_X11_None None
-#undef None
-#endif
-
-// 包含X11头文件
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
-#include <X11/Xatom.h>
-
-// 恢复Qt宏定义
-#ifdef QT_X11_Bool
-#define Bool QT_X11_Bool
-#undef QT_X11_Bool
+#ifdef Q_OS_UNIX
+#include <sys/types.h>
+#include <unistd.h>
 #endif
 
-#ifdef QT_X11_Status
-#define Status QT_X11_Status
-#undef QT_X11_Status
-#endif
-
-#ifdef QT_X11_Unsorted
-#define Unsorted QT_X11_Unsorted
-#undef QT_X11_Unsorted
-#endif
-
-#ifdef QT_X11_None
-#define None QT_X11_None
-#undef QT_X11_None
-#endif
-
-#endif // Q_OS_LINUX
-
-FlightControlsLauncher::FlightControlsLauncher(QWidget *parent)
+FlightControlsLauncher::FlightControlsLauncher(Supervisor *supervisor, QWidget *parent)
     : QWidget(parent)
     , m_mainLayout(nullptr)
     , m_buttonLayout(nullptr)
     , m_statusLayout(nullptr)
-    , m_qgcButton(nullptr)
-    , m_rvizButton(nullptr)
     , m_closeButton(nullptr)
     , m_statusLabel(nullptr)
-    , m_statusTimer(nullptr)
+    , m_supervisor(supervisor)
     , m_windowSearchTimer(nullptr)
-    , m_retryTimer(nullptr)
-    , m_searchRetryCount(0)
+    , m_windowWatcher(nullptr)
+    , m_windowEventTimer(nullptr)
+    , m_windowEventTimeoutTimer(nullptr)
+    , m_closeRequested(false)
     , m_dragging(false)
-#ifdef Q_OS_LINUX
-    , m_display(nullptr)
-#endif
+    , m_dragMode(DragMode::System)
+    , m_dragTimer(nullptr)
+    , m_x11(nullptr)
+    , m_shadowMargin(0)
 {
     qDebug() << "创建飞行控制应用程序启动器";
     
-    // 初始化X11显示连接
-#ifdef Q_OS_LINUX
-    m_display = XOpenDisplay(nullptr);
-    if (!m_display) {
-        qWarning() << "无法连接到X11显示服务器，窗口管理功能可能不可用";
-    } else {
-        qDebug() << "X11显示服务器连接成功";
-    }
-#endif
+    // 初始化X11连接（一次取得所有原子）
+    m_x11 = new X11Service(this);
     
-    setupUI();
-    setupButtons();
-    positionWindow();
-    applyStyles();
+    // 阴影只在有合成器时绘制，否则透明边距会显示为黑边
+    m_shadowMargin = m_x11->isCompositing() ? SHADOW_MARGIN : 0;
     
-    // 设置状态更新定时器
-    m_statusTimer = new QTimer(this);
-    connect(m_statusTimer, &QTimer::timeout, this, &FlightControlsLauncher::updateStatus);
-    m_statusTimer->start(STATUS_UPDATE_INTERVAL);
+    {
+        StartupTrace::Scope trace("setupUI");
+        setupUI();
+        setupButtons();
+        positionWindow();
+    }
+    {
+        StartupTrace::Scope trace("applyStyles");
+        applyStyles();
+    }
     
-    // 设置窗口搜索定时器
+    // 设置窗口搜索定时器（首次搜索和重试共用，按最早到期的应用启动）
     m_windowSearchTimer = new QTimer(this);
     m_windowSearchTimer->setSingleShot(true);
     connect(m_windowSearchTimer, &QTimer::timeout, this, &FlightControlsLauncher::findAndMaximizeWindows);
+    m_windowClock.start();
     
-    // 设置重试定时器
-    m_retryTimer = new QTimer(this);
-    m_retryTimer->setSingleShot(true);
-    connect(m_retryTimer, &QTimer::timeout, this, &FlightControlsLauncher::retryWindowSearch);
+    // 设置事件驱动窗口发现 - 同一批事件只触发一次搜索
+    m_windowEventTimer = new QTimer(this);
+    m_windowEventTimer->setSingleShot(true);
+    m_windowEventTimer->setInterval(0);
+    connect(m_windowEventTimer, &QTimer::timeout, this, &FlightControlsLauncher::checkPendingWindows);
     
-    // 注册应用程序
-    AppProcess qgcApp;
-    qgcApp.name = "QGroundControl";
-    qgcApp.command = ""; // 将在启动时动态确定路径
-    qgcApp.arguments = QStringList();
-    qgcApp.process = nullptr;
-    qgcApp.isRunning = false;
-    qgcApp.windowTitlePattern = "QGroundControl";
-    m_applications["QGC"] = qgcApp;
+    m_windowEventTimeoutTimer = new QTimer(this);
+    m_windowEventTimeoutTimer->setSingleShot(true);
+    connect(m_windowEventTimeoutTimer, &QTimer::timeout, this, &FlightControlsLauncher::onWindowEventTimeout);
     
-    // 注册rviz进程 - 使用终端窗口启动，确保环境变量正确
-    AppProcess rvizApp;
-    rvizApp.name = "RVIZ";
-    rvizApp.windowTitlePattern = "RViz";
+    // 拖动合并：每帧最多移动一次窗口
+    m_dragTimer = new QTimer(this);
+    m_dragTimer->setSingleShot(true);
+    m_dragTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_dragTimer, &QTimer::timeout, this, &FlightControlsLauncher::applyPendingDrag);
     
-    // 尝试多种终端，确保兼容性
-    QStringList terminals = {"gnome-terminal", "konsole", "xfce4-terminal", "xterm"};
-    QString availableTerminal;
-    
-    for (const QString &terminal : terminals) {
-        if (QProcess::execute("which", QStringList() << terminal) == 0) {
-            availableTerminal = terminal;
-            break;
-        }
-    }
-    
-    if (availableTerminal.isEmpty()) {
-        qWarning() << "未找到可用的终端程序，RVIZ功能可能不可用";
-        rvizApp.command = "echo";
-        rvizApp.arguments = QStringList() << "未找到终端程序";
+#ifdef Q_OS_LINUX
+    StartupTrace::begin("X11WindowWatcher");
+    m_windowWatcher = new X11WindowWatcher(m_x11, this);
+    StartupTrace::end("X11WindowWatcher");
+    if (m_windowWatcher->isActive()) {
+        connect(m_windowWatcher, &X11WindowWatcher::windowMapped, this, &FlightControlsLauncher::onWindowEvent);
+        connect(m_windowWatcher, &X11WindowWatcher::clientListChanged, this, &FlightControlsLauncher::onWindowEvent);
+        connect(m_windowWatcher, &X11WindowWatcher::windowChanged, this, &FlightControlsLauncher::onWindowEvent);
+        qDebug() << "窗口发现模式: 事件驱动";
     } else {
-        qDebug() << "使用终端程序:" << availableTerminal;
-        rvizApp.command = availableTerminal;
-        
-        // 根据不同终端设置不同的参数 - 添加隐藏选项
-        QString rvizCommand = "echo '正在启动ROS和RVIZ...'; "
-                             "source /opt/ros/*/setup.bash 2>/dev/null || echo 'ROS环境已加载'; "
-                             "roscore >/dev/null 2>&1 & sleep 3; "
-                             "nohup rosrun rviz rviz >/dev/null 2>&1 & "
-                             "sleep 1; exit";
-        
-        if (availableTerminal == "gnome-terminal") {
-            // 使用 --geometry 最小化终端大小，并立即退出
-            rvizApp.arguments = QStringList() << "--geometry=1x1+0+0" << "--" << "bash" << "-c" << rvizCommand;
-        } else if (availableTerminal == "konsole") {
-            rvizApp.arguments = QStringList() << "--geometry" << "1x1+0+0" << "-e" << "bash" << "-c" << rvizCommand;
-        } else if (availableTerminal == "xfce4-terminal") {
-            rvizApp.arguments = QStringList() << "--geometry=1x1+0+0" << "-e" << "bash" << "-c" << rvizCommand;
-        } else { // xterm or others
-            rvizApp.arguments = QStringList() << "-geometry" << "1x1+0+0" << "-e" << "bash" << "-c" << rvizCommand;
-        }
+        qDebug() << "窗口发现模式: 定时轮询";
     }
-    rvizApp.process = nullptr;
-    rvizApp.isRunning = false;
-    m_applications["RVIZ"] = rvizApp;
+#endif
+    
+    // 状态显示完全由Supervisor的事件驱动，不定时刷新
+    m_supervisor->setWindowManagementAvailable(true);
+    connect(m_supervisor, &Supervisor::stateChanged, this, &FlightControlsLauncher::updateStatus);
+    connect(m_supervisor, &Supervisor::launchFailed, this, &FlightControlsLauncher::onLaunchFailed);
+    connect(m_supervisor, &Supervisor::restartAbandoned, this, &FlightControlsLauncher::onRestartAbandoned);
+    connect(m_supervisor, &Supervisor::windowSearchRequested, this, &FlightControlsLauncher::scheduleWindowSearch);
+    connect(m_supervisor, &Supervisor::applicationStopped, this, [this](const QString &appId) {
+        m_pendingWindows.remove(m_supervisor->indexOf(appId));
+    });
     
+    // 启动耗时摘要显示在状态标签的提示中，资源采样更新到按钮提示
+    connect(m_supervisor->launchTimeline(), &LaunchTimeline::summaryChanged, m_statusLabel, &QLabel::setToolTip);
+    connect(m_supervisor->resourceMonitor(), &ResourceMonitor::updated, this, &FlightControlsLauncher::updateToolTips);
+    
+    updateStatus();
     qDebug() << "飞行控制启动器初始化完成";
 }
 
@@ -174,392 +126,333 @@ FlightControlsLauncher::~FlightControlsLauncher()
     qDebug() << "销毁飞行控制启动器，清理资源...";
     
     // 停止定时器
-    if (m_statusTimer) {
-        m_statusTimer->stop();
-    }
     if (m_windowSearchTimer) {
         m_windowSearchTimer->stop();
     }
-    if (m_retryTimer) {
-        m_retryTimer->stop();
+    if (m_windowEventTimer) {
+        m_windowEventTimer->stop();
+    }
+    if (m_windowEventTimeoutTimer) {
+        m_windowEventTimeoutTimer->stop();
     }
     
-    // 停止所有应用程序
-    stopAllApplications();
+    // 应用程序由Supervisor负责清理，这里只断开窗口管理
+    m_supervisor->disconnect(this);
+    m_supervisor->setWindowManagementAvailable(false);
     
-    // 关闭X11显示连接
+    // 关闭X11连接（先取消事件订阅）
 #ifdef Q_OS_LINUX
-    if (m_display) {
-        XCloseDisplay(m_display);
-        m_display = nullptr;
-    }
+    delete m_windowWatcher;
+    m_windowWatcher = nullptr;
 #endif
+    delete m_x11;
+    m_x11 = nullptr;
     
     qDebug() << "资源清理完成";
 }
 
-QString FlightControlsLauncher::findQGroundControlPath()
+unsigned long FlightControlsLauncher::findApplicationWindow(int index)
 {
-    QStringList searchPaths = {
-        // 当前工作目录
-        "./QGroundControl.AppImage",
-        // 程序所在目录
-        QApplication::applicationDirPath() + "/QGroundControl.AppImage",
-        // build目录（开发时）
-        "./build/QGroundControl.AppImage",
-        "../QGroundControl.AppImage",
-        // 常见安装路径
-        "/usr/local/bin/QGroundControl.AppImage",
-        "/opt/QGroundControl/QGroundControl.AppImage"
-    };
-    
-    for (const QString &path : searchPaths) {
-        QFileInfo fileInfo(path);
-        if (fileInfo.exists() && fileInfo.isExecutable()) {
-            qDebug() << "找到QGroundControl:" << fileInfo.absoluteFilePath();
-            return fileInfo.absoluteFilePath();
-        }
+#ifdef Q_OS_LINUX
+    if (!m_windowWatcher || !m_windowWatcher->isActive()) {
+        return 0;
     }
     
-    qWarning() << "未找到QGroundControl.AppImage文件";
-    return QString();
-}
-
-void FlightControlsLauncher::stopAllApplications()
-{
-    qDebug() << "停止所有应用程序...";
+    const AppDefinition &definition = m_supervisor->definition(index);
+    const QString &appId = definition.id;
+    const QList<qint64> processGroupIds = m_supervisor->processGroupIds(index);
+    const QVector<X11WindowWatcher::ClientWindow> &clients = m_windowWatcher->clients();
     
-    // 停止所有运行中的应用程序 - 使用新的增强停止机制
-    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
-        if (it.value().isRunning) {
-            stopApplication(it.key());
+    // 1. _NET_WM_PID所属进程组是本次启动的进程组（列表按映射顺序，取最新的窗口）
+    if (!processGroupIds.isEmpty()) {
+        for (int i = clients.size() - 1; i >= 0; --i) {
+            const X11WindowWatcher::ClientWindow &client = clients.at(i);
+            if (client.pid <= 0) {
+                continue;
+            }
+            pid_t processGroupId = ::getpgid(static_cast<pid_t>(client.pid));
+            if (processGroupId > 0 && processGroupIds.contains(processGroupId)) {
+                qDebug() << "✅ 按进程组找到" << appId << "窗口 [ID:" << client.windowId
+                        << "PID:" << client.pid << "WM_CLASS:" << client.wmClass << "]";
+                return client.windowId;
+            }
         }
     }
     
-    // 额外的系统级清理（保留作为最后保险）
-    qDebug() << "执行系统级进程清理...";
-    QProcess::execute("pkill", QStringList() << "-f" << "QGroundControl");
-    QProcess::execute("pkill", QStringList() << "-f" << "roscore");
-    QProcess::execute("pkill", QStringList() << "-f" << "rviz");
-    QProcess::execute("pkill", QStringList() << "-f" << "gnome-terminal.*RVIZ");
+    // 2. WM_CLASS匹配：只用于无法按进程组判断的窗口。跟踪进程组的启动只考虑没有_NET_WM_PID的窗口，
+    //    否则屏幕上已有的同类窗口（旧实例或从终端启动的）会被当成本次启动的窗口；
+    //    无法跟踪进程组时只有终端启动才按类名匹配
+    const QString &windowClass = definition.windowClass;
+    const bool trackedLaunch = !processGroupIds.isEmpty();
+    if (!windowClass.isEmpty() && (trackedLaunch || m_supervisor->isDetached(index))) {
+        for (int i = clients.size() - 1; i >= 0; --i) {
+            const X11WindowWatcher::ClientWindow &client = clients.at(i);
+            if (trackedLaunch && client.pid > 0) {
+                continue;
+            }
+            if (client.wmClass.compare(windowClass, Qt::CaseInsensitive) == 0 ||
+                client.wmInstance.compare(windowClass, Qt::CaseInsensitive) == 0) {
+                qDebug() << "✅ 按WM_CLASS找到" << appId << "窗口 [ID:" << client.windowId << "]";
+                return client.windowId;
+            }
+        }
+    }
     
-    qDebug() << "所有应用程序已停止";
+    // 3. 窗口管理器不支持EWMH或应用未设置属性时，退回标题匹配
+    if (clients.isEmpty()) {
+        return findWindowByTitle(definition.windowTitles);
+    }
+    qDebug() << appId << "的窗口尚未出现在_NET_CLIENT_LIST中";
+    return 0;
+#else
+    Q_UNUSED(index)
+    return 0;
+#endif
 }
 
-unsigned long FlightControlsLauncher::findWindowByTitle(const QString &titlePattern)
+unsigned long FlightControlsLauncher::findWindowByTitle(const QStringList &titlePatterns)
 {
 #ifdef Q_OS_LINUX
-    if (!m_display) {
+    if (!m_windowWatcher || !m_windowWatcher->isActive()) {
         qDebug() << "X11显示连接无效，无法搜索窗口";
         return 0;
     }
+    if (titlePatterns.isEmpty()) {
+        return 0;
+    }
     
-    qDebug() << "开始搜索窗口，匹配模式:" << titlePattern;
+    // 在事件增量维护的窗口索引中查找，不产生X服务器往返
+    const QHash<unsigned long, X11WindowWatcher::WindowInfo> &windows = m_windowWatcher->windows();
+    qDebug() << "开始搜索窗口，匹配模式:" << titlePatterns << "已索引窗口:" << windows.size();
     
-    Window root = DefaultRootWindow(m_display);
-    Window parent, *children;
-    unsigned int nchildren;
+    // 同一应用可能有多个匹配标题的窗口（启动画面、子窗口等），按尺寸和可见性评分取最佳
+    unsigned long bestWindowId = 0;
+    int bestScore = -1;
     
-    // 用于收集RVIZ候选窗口
-    struct RvizCandidate {
-        unsigned long windowId;
-        QString title;
-        int width, height;
-        int score; // 评分，越高越好
-    };
-    QList<RvizCandidate> rvizCandidates;
-    
-    if (XQueryTree(m_display, root, &root, &parent, &children, &nchildren)) {
-        qDebug() << "找到" << nchildren << "个窗口，开始逐个检查...";
+    for (auto it = windows.constBegin(); it != windows.constEnd(); ++it) {
+        const X11WindowWatcher::WindowInfo &info = it.value();
+        if (!info.hasTitle || info.title.isEmpty()) {
+            continue;
+        }
         
-        for (unsigned int i = 0; i < nchildren; ++i) {
-            char *window_name = nullptr;
-            if (XFetchName(m_display, children[i], &window_name) && window_name) {
-                QString windowTitle = QString::fromUtf8(window_name);
-                
-                // 增加调试信息 - 显示所有窗口标题
-                qDebug() << "检查窗口[" << i << "]:" << windowTitle << "[ID:" << children[i] << "]";
-                
-                // 更灵活的匹配逻辑
-                bool titleMatch = false;
-                if (titlePattern == "QGroundControl") {
-                    // QGC可能的标题变体
-                    titleMatch = windowTitle.contains("QGroundControl", Qt::CaseInsensitive) ||
-                                windowTitle.contains("QGC", Qt::CaseInsensitive) ||
-                                windowTitle.contains("Ground Control", Qt::CaseInsensitive) ||
-                                windowTitle.contains("qgroundcontrol", Qt::CaseInsensitive);
-                } else if (titlePattern == "RViz") {
-                    // RVIZ可能的标题变体 - 根据实际日志更新，增加更多格式
-                    titleMatch = windowTitle.contains("RViz", Qt::CaseInsensitive) ||
-                                windowTitle.contains("rviz", Qt::CaseInsensitive) ||
-                                windowTitle.contains("ROS Visualization", Qt::CaseInsensitive) ||
-                                windowTitle.contains("default.rviz", Qt::CaseInsensitive) ||
-                                windowTitle.contains("- RViz", Qt::CaseInsensitive) ||
-                                windowTitle.contains(".rviz", Qt::CaseInsensitive) ||
-                                // 新增更多可能的标题格式
-                                windowTitle.contains("Visualization", Qt::CaseInsensitive) ||
-                                windowTitle.contains("ROS", Qt::CaseInsensitive) ||
-                                windowTitle.contains("Display", Qt::CaseInsensitive) ||
-                                windowTitle.contains("3D View", Qt::CaseInsensitive) ||
-                                // Qt应用程序可能的标题
-                                (windowTitle.contains("Qt", Qt::CaseInsensitive) && 
-                                 (windowTitle.contains("rviz", Qt::CaseInsensitive) || 
-                                  windowTitle.contains("RViz", Qt::CaseInsensitive))) ||
-                                // 空标题但可能是RVIZ的子窗口（将在获取属性后再检查尺寸）
-                                windowTitle.isEmpty();
-                } else {
-                    // 默认匹配
-                    titleMatch = windowTitle.contains(titlePattern, Qt::CaseInsensitive);
-                }
-                
-                if (titleMatch) {
-                    qDebug() << "找到匹配的窗口标题:" << windowTitle;
-                    
-                    // 检查窗口是否可见和有效 - 先获取窗口属性
-                    XWindowAttributes attrs;
-                    if (XGetWindowAttributes(m_display, children[i], &attrs)) {
-                        qDebug() << "窗口属性 - 状态:" << attrs.map_state 
-                                << "尺寸:" << attrs.width << "x" << attrs.height
-                                << "位置:" << attrs.x << "," << attrs.y;
-                        
-                        if (titlePattern == "RViz") {
-                            // 对于空标题的窗口，需要检查尺寸是否足够大
-                            bool isValidEmptyTitle = !windowTitle.isEmpty() || 
-                                                   (windowTitle.isEmpty() && attrs.width > 200 && attrs.height > 200);
-                            
-                            // 收集所有RVIZ候选窗口
-                            if (attrs.width > 0 && attrs.height > 0 && isValidEmptyTitle) {
-                                RvizCandidate candidate;
-                                candidate.windowId = children[i];
-                                candidate.title = windowTitle;
-                                candidate.width = attrs.width;
-                                candidate.height = attrs.height;
-                                
-                                // 计算评分
-                                candidate.score = 0;
-                                if (attrs.width >= 800 && attrs.height >= 600) candidate.score += 100; // 大窗口高分
-                                else if (attrs.width >= 300 && attrs.height >= 200) candidate.score += 50; // 中等窗口
-                                else candidate.score += 10; // 小窗口低分
-                                
-                                if (attrs.map_state == IsViewable) candidate.score += 30; // 可见窗口加分
-                                if (windowTitle.contains("default.rviz", Qt::CaseInsensitive)) candidate.score += 20; // 包含配置文件名加分
-                                
-                                rvizCandidates.append(candidate);
-                                qDebug() << "添加RVIZ候选窗口 - 标题:" << windowTitle 
-                                        << "尺寸:" << attrs.width << "x" << attrs.height 
-                                        << "评分:" << candidate.score;
-                            }
-                        } else {
-                            // 非RVIZ窗口使用原有逻辑
-                            bool windowValid = (attrs.map_state == IsViewable && attrs.width > 50 && attrs.height > 50);
-                            if (windowValid) {
-                                qDebug() << "✅ 找到有效窗口:" << windowTitle << "[ID:" << children[i] << "]";
-                                XFree(window_name);
-                                XFree(children);
-                                return children[i];
-                            } else {
-                                qDebug() << "⚠️ 窗口不满足条件 - 状态:" << (attrs.map_state == IsViewable ? "可见" : "不可见")
-                                        << "尺寸:" << attrs.width << "x" << attrs.height;
-                            }
-                        }
-                    } else {
-                        qDebug() << "❌ 无法获取窗口属性";
-                    }
-                }
-                
-                XFree(window_name);
+        bool titleMatch = false;
+        for (const QString &pattern : titlePatterns) {
+            if (info.title.contains(pattern, Qt::CaseInsensitive)) {
+                titleMatch = true;
+                break;
             }
         }
-        XFree(children);
+        if (!titleMatch) {
+            continue;
+        }
         
-        // 处理RVIZ候选窗口
-        if (titlePattern == "RViz" && !rvizCandidates.isEmpty()) {
-            qDebug() << "找到" << rvizCandidates.size() << "个RVIZ候选窗口，选择最佳的...";
-            
-            // 按评分排序，选择最高分的
-            std::sort(rvizCandidates.begin(), rvizCandidates.end(), 
-                     [](const RvizCandidate &a, const RvizCandidate &b) {
-                         return a.score > b.score;
-                     });
-            
-            auto best = rvizCandidates.first();
-            
-            // 特殊处理：如果最佳窗口仍然很小，可能RVIZ还没完全启动
-            if (best.width <= 50 && best.height <= 50) {
-                qDebug() << "⚠️ 最佳RVIZ窗口尺寸很小(" << best.width << "x" << best.height 
-                        << ")，可能RVIZ还没完全启动";
-                qDebug() << "建议：等待更长时间让RVIZ完全加载";
-                
-                // 如果评分太低，返回0表示未找到合适窗口，触发重试
-                if (best.score < 50) {
-                    qDebug() << "❌ 最佳窗口评分过低(" << best.score << ")，返回未找到以触发重试";
-                    return 0;
-                }
-            }
-            
-            qDebug() << "✅ 选择最佳RVIZ窗口:" << best.title 
-                    << "[ID:" << best.windowId << "] 尺寸:" << best.width << "x" << best.height 
-                    << "评分:" << best.score;
-            return best.windowId;
+        qDebug() << "找到匹配的窗口标题:" << info.title << "[ID:" << it.key() << "]"
+                << "可见:" << info.viewable << "尺寸:" << info.width << "x" << info.height
+                << "位置:" << info.x << "," << info.y;
+        
+        // 过小的窗口通常是应用尚未完全启动，返回未找到以触发重试
+        if (info.width <= 50 || info.height <= 50) {
+            qDebug() << "⚠️ 窗口尺寸过小，应用可能尚未完全启动";
+            continue;
         }
         
-        qDebug() << "窗口搜索完成，未找到匹配的窗口";
-    } else {
-        qDebug() << "❌ 无法获取窗口树";
+        int score = 0;
+        if (info.width >= 800 && info.height >= 600) score += 100; // 大窗口高分
+        else if (info.width >= 300 && info.height >= 200) score += 50; // 中等窗口
+        else score += 10; // 小窗口低分
+        if (info.viewable) score += 30; // 可见窗口加分
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestWindowId = it.key();
+        }
+    }
+    
+    if (bestWindowId > 0) {
+        qDebug() << "✅ 选择最佳窗口 [ID:" << bestWindowId << "] 评分:" << bestScore;
+        return bestWindowId;
     }
+    
+    qDebug() << "窗口搜索完成，未找到匹配的窗口";
 #else
-    Q_UNUSED(titlePattern)
+    Q_UNUSED(titlePatterns)
     qDebug() << "非Linux系统，跳过窗口搜索";
 #endif
     
     return 0;
 }
 
-void FlightControlsLauncher::setWindowMaximized(unsigned long windowId)
+void FlightControlsLauncher::findAndMaximizeWindows()
 {
-#ifdef Q_OS_LINUX
-    if (!m_display || windowId == 0) {
-        return;
+    const qint64 now = m_windowClock.elapsed();
+    const QList<int> pendingApps = m_pendingWindows.keys();
+    for (int index : pendingApps) {
+        // 最大化前一个窗口时的回调可能已移除该应用
+        auto it = m_pendingWindows.find(index);
+        if (it == m_pendingWindows.end()) {
+            continue;
+        }
+        PendingWindow &pending = it.value();
+        if (pending.due > now) {
+            continue;
+        }
+        const AppDefinition &definition = m_supervisor->definition(index);
+        if (!m_supervisor->isActive(index)) {
+            m_pendingWindows.remove(index);
+            continue;
+        }
+        qDebug() << "搜索应用程序:" << definition.id << "窗口模式:" << definition.windowTitles
+                 << "（尝试次数:" << (pending.retryCount + 1) << "/" << (WINDOW_SEARCH_MAX_RETRIES + 1) << ")";
+        
+        unsigned long windowId = findApplicationWindow(index);
+        if (windowId > 0) {
+            m_pendingWindows.remove(index);
+            onApplicationWindowFound(index, windowId);
+            qDebug() << "✅" << definition.id << "窗口已最大化并置前";
+        } else if (pending.retryCount < WINDOW_SEARCH_MAX_RETRIES) {
+            // 只推迟该应用自己的下一次搜索
+            pending.retryCount++;
+            pending.due = now + WINDOW_SEARCH_RETRY_DELAY;
+            qDebug() << "❌ 未找到" << definition.id << "窗口，" << WINDOW_SEARCH_RETRY_DELAY
+                     << "毫秒后进行第" << pending.retryCount << "次重试...";
+        } else {
+            qDebug() << "⚠️" << definition.id << "达到最大重试次数，窗口搜索结束";
+            m_pendingWindows.remove(index);
+            m_supervisor->launchTimeline()->finish(definition.id, "window-timeout");
+        }
     }
     
-    // 设置窗口最大化状态
-    Atom wmState = XInternAtom(m_display, "_NET_WM_STATE", False);
-    Atom maxHorz = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
-    Atom maxVert = XInternAtom(m_display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
-    
-    XEvent xev;
-    memset(&xev, 0, sizeof(xev));
-    xev.type = ClientMessage;
-    xev.xclient.window = windowId;
-    xev.xclient.message_type = wmState;
-    xev.xclient.format = 32;
-    xev.xclient.data.l[0] = 1; // _NET_WM_STATE_ADD
-    xev.xclient.data.l[1] = maxHorz;
-    xev.xclient.data.l[2] = maxVert;
-    
-    XSendEvent(m_display, DefaultRootWindow(m_display), False,
-               SubstructureRedirectMask | SubstructureNotifyMask, &xev);
-    
-    XFlush(m_display);
-    qDebug() << "设置窗口最大化:" << windowId;
-#else
-    Q_UNUSED(windowId)
-#endif
+    rearmWindowTimer();
 }
 
-void FlightControlsLauncher::raiseWindow(unsigned long windowId)
+void FlightControlsLauncher::scheduleWindowSearch(int index)
 {
-#ifdef Q_OS_LINUX
-    if (!m_display || windowId == 0) {
+    const AppDefinition &definition = m_supervisor->definition(index);
+    // 重新开始该应用的等待，其他等待中的应用保持各自的截止时间和重试次数
+    PendingWindow pending;
+    
+    if (m_windowWatcher && m_windowWatcher->isActive()) {
+        // 事件驱动模式：窗口映射后立即处理，无需固定延迟
+        pending.due = m_windowClock.elapsed() + WINDOW_EVENT_TIMEOUT;
+        m_pendingWindows.insert(index, pending);
+        rearmWindowTimer();
+        qDebug() << "等待" << definition.id << "窗口映射事件...";
+        
+        // 窗口可能已经存在（例如应用程序之前已启动）
+        m_windowEventTimer->start();
         return;
     }
     
-    // 将窗口置前
-    XRaiseWindow(m_display, windowId);
-    
-    // 设置输入焦点
-    XSetInputFocus(m_display, windowId, RevertToPointerRoot, CurrentTime);
-    
-    // 激活窗口
-    Atom activeWindow = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
-    XEvent xev;
-    memset(&xev, 0, sizeof(xev));
-    xev.type = ClientMessage;
-    xev.xclient.window = windowId;
-    xev.xclient.message_type = activeWindow;
-    xev.xclient.format = 32;
-    xev.xclient.data.l[0] = 2; // 来自应用程序的请求
-    xev.xclient.data.l[1] = CurrentTime;
-    
-    XSendEvent(m_display, DefaultRootWindow(m_display), False,
-               SubstructureRedirectMask | SubstructureNotifyMask, &xev);
-    
-    XFlush(m_display);
-    qDebug() << "窗口已置前:" << windowId;
-#else
-    Q_UNUSED(windowId)
-#endif
+    // 回退：定时轮询模式。已通过就绪探测的应用立即搜索，否则按注册表声明的延迟猜测
+    int searchDelay = definition.windowSearchDelay;
+    if (m_supervisor->isReady(index) && definition.readiness.type != "none" && definition.readiness.type != "window") {
+        searchDelay = 0;
+    }
+    pending.due = m_windowClock.elapsed() + searchDelay;
+    m_pendingWindows.insert(index, pending);
+    qDebug() << "将在" << searchDelay << "毫秒后开始搜索" << definition.id << "窗口...";
+    rearmWindowTimer();
 }
 
-void FlightControlsLauncher::maximizeAndRaiseWindow(const QString &appName)
+void FlightControlsLauncher::rearmWindowTimer()
 {
-    if (!m_applications.contains(appName)) {
+    // 事件驱动模式下定时器只负责超时，轮询模式下负责下一次搜索
+    QTimer *timer = (m_windowWatcher && m_windowWatcher->isActive()) ? m_windowEventTimeoutTimer : m_windowSearchTimer;
+    if (m_pendingWindows.isEmpty()) {
+        timer->stop();
         return;
     }
     
-    const AppProcess &app = m_applications[appName];
-    unsigned long windowId = findWindowByTitle(app.windowTitlePattern);
-    
-    if (windowId > 0) {
-        setWindowMaximized(windowId);
-        raiseWindow(windowId);
-        qDebug() << appName << "窗口已最大化并置前";
-    } else {
-        qDebug() << "未找到" << appName << "窗口";
+    qint64 earliest = m_pendingWindows.constBegin()->due;
+    for (auto it = m_pendingWindows.constBegin(); it != m_pendingWindows.constEnd(); ++it) {
+        earliest = qMin(earliest, it->due);
     }
+    timer->start(static_cast<int>(qMax<qint64>(0, earliest - m_windowClock.elapsed())));
 }
 
-void FlightControlsLauncher::findAndMaximizeWindows()
+void FlightControlsLauncher::onWindowEvent()
 {
-    qDebug() << "搜索并最大化应用程序窗口...（尝试次数:" << (m_searchRetryCount + 1) << "/" << (WINDOW_SEARCH_MAX_RETRIES + 1) << ")";
-    
-    bool foundAnyWindow = false;
-    bool foundSmallRvizWindow = false;
-    
-    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
-        if (it.value().isRunning) {
-            qDebug() << "搜索应用程序:" << it.key() << "窗口模式:" << it.value().windowTitlePattern;
-            
-            unsigned long windowId = findWindowByTitle(it.value().windowTitlePattern);
-            if (windowId > 0) {
-                setWindowMaximized(windowId);
-                raiseWindow(windowId);
-                qDebug() << "✅" << it.key() << "窗口已最大化并置前";
-                foundAnyWindow = true;
-            } else {
-                qDebug() << "❌ 未找到" << it.key() << "窗口";
-                
-                // 特殊处理RVIZ：检查是否因为小窗口被拒绝
-                if (it.key() == "RVIZ") {
-                    // 这里windowId为0表示findWindowByTitle返回了0，可能是因为小窗口被拒绝
-                    foundSmallRvizWindow = true;
-                    qDebug() << "RVIZ窗口可能存在但尺寸过小，需要更多时间启动";
-                }
-            }
-        }
+    if (m_pendingWindows.isEmpty()) {
+        return;
     }
     
-    // 如果没有找到任何窗口且重试次数未达到最大值，启动重试
-    if (!foundAnyWindow && m_searchRetryCount < WINDOW_SEARCH_MAX_RETRIES) {
-        m_searchRetryCount++;
-        
-        // 为RVIZ小窗口情况提供更长的重试延迟
-        int retryDelay = WINDOW_SEARCH_RETRY_DELAY;
-        if (foundSmallRvizWindow) {
-            retryDelay = WINDOW_SEARCH_RETRY_DELAY + 2000; // RVIZ额外等待2秒
-            qDebug() << "检测到RVIZ小窗口，延长重试间隔至" << retryDelay << "毫秒";
+    // 合并同一批事件，下一轮事件循环统一搜索
+    if (!m_windowEventTimer->isActive()) {
+        m_windowEventTimer->start();
+    }
+}
+
+void FlightControlsLauncher::checkPendingWindows()
+{
+    const QList<int> pendingApps = m_pendingWindows.keys();
+    for (int index : pendingApps) {
+        // 最大化前一个窗口时的回调可能已移除该应用
+        if (!m_pendingWindows.contains(index)) {
+            continue;
+        }
+        if (!m_supervisor->isActive(index)) {
+            m_pendingWindows.remove(index);
+            continue;
         }
         
-        qDebug() << "未找到窗口，" << retryDelay << "毫秒后进行第" << m_searchRetryCount << "次重试...";
-        m_retryTimer->start(retryDelay);
-    } else {
-        // 重置重试计数器
-        m_searchRetryCount = 0;
-        if (foundAnyWindow) {
-            qDebug() << "🎉 窗口搜索和管理完成！";
+        const QString &appId = m_supervisor->definition(index).id;
+        unsigned long windowId = findApplicationWindow(index);
+        if (windowId > 0) {
+            m_pendingWindows.remove(index);
+            onApplicationWindowFound(index, windowId);
+            qDebug() << "✅" << appId << "窗口映射后已立即最大化并置前";
+        }
+    }
+    
+    rearmWindowTimer();
+}
+
+void FlightControlsLauncher::onWindowEventTimeout()
+{
+    // 只结束已超过各自截止时间的应用，其余继续等待
+    const qint64 now = m_windowClock.elapsed();
+    QStringList expiredIds;
+    for (auto it = m_pendingWindows.begin(); it != m_pendingWindows.end();) {
+        if (it->due <= now) {
+            expiredIds << m_supervisor->definition(it.key()).id;
+            it = m_pendingWindows.erase(it);
         } else {
-            qDebug() << "⚠️ 达到最大重试次数，窗口搜索结束";
-            if (foundSmallRvizWindow) {
-                qDebug() << "💡 建议：手动检查RVIZ是否正在启动中，或尝试重新启动RVIZ";
-            }
+            ++it;
         }
     }
+    for (const QString &appId : expiredIds) {
+        m_supervisor->launchTimeline()->finish(appId, "window-timeout");
+    }
+    if (!expiredIds.isEmpty()) {
+        qDebug() << "⚠️ 等待窗口超时，仍未找到:" << expiredIds;
+    }
+    
+    rearmWindowTimer();
+}
+
+void FlightControlsLauncher::onApplicationWindowFound(int index, unsigned long windowId)
+{
+    m_supervisor->launchTimeline()->mark(m_supervisor->definition(index).id, "window-found");
+    
+    // 终端启动的进程不是启动器的子进程，只能通过窗口的_NET_WM_PID得知其退出
+    if (m_supervisor->isDetached(index) && m_windowWatcher) {
+        m_supervisor->attachDetachedProcess(index, m_windowWatcher->windowPid(windowId));
+    }
+    // 以窗口映射作为就绪条件的应用，此时才推进依赖它的启动
+    m_supervisor->notifyWindowFound(index);
+    
+    // 两个请求一次发出，不等待回复
+    m_x11->maximizeWindow(windowId);
+    m_x11->activateWindow(windowId);
+    m_x11->flush();
+    onWindowMaximized(index);
 }
 
-void FlightControlsLauncher::retryWindowSearch()
+void FlightControlsLauncher::onWindowMaximized(int index)
 {
-    qDebug() << "执行窗口搜索重试...";
-    findAndMaximizeWindows();
+    const QString &appId = m_supervisor->definition(index).id;
+    m_supervisor->launchTimeline()->mark(appId, "window-maximized");
+    m_supervisor->launchTimeline()->finish(appId, "maximized");
 }
 
 void FlightControlsLauncher::setupUI()
@@ -567,11 +460,11 @@ void FlightControlsLauncher::setupUI()
     // 设置窗口属性
     setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::Tool);
     setAttribute(Qt::WA_TranslucentBackground);
-    setFixedSize(LAUNCHER_WIDTH, LAUNCHER_HEIGHT);
+    setFixedSize(LAUNCHER_WIDTH + 2 * m_shadowMargin, LAUNCHER_HEIGHT + 2 * m_shadowMargin);
     
-    // 创建主布局
+    // 创建主布局（外圈留出阴影边距）
     m_mainLayout = new QVBoxLayout(this);
-    m_mainLayout->setContentsMargins(15, 10, 15, 10);
+    m_mainLayout->setContentsMargins(15 + m_shadowMargin, 10 + m_shadowMargin, 15 + m_shadowMargin, 10 + m_shadowMargin);
     m_mainLayout->setSpacing(8);
     
     // 创建按钮布局
@@ -588,20 +481,45 @@ void FlightControlsLauncher::setupUI()
 
 void FlightControlsLauncher::setupButtons()
 {
-    // QGroundControl按钮
-    m_qgcButton = new QPushButton("🚁 启动 QGC", this);
-    m_qgcButton->setMinimumSize(100, 35);
-    connect(m_qgcButton, &QPushButton::clicked, this, &FlightControlsLauncher::onLaunchQGC);
-    
-    // RVIZ按钮
-    m_rvizButton = new QPushButton("🤖 启动 RVIZ", this);
-    m_rvizButton->setMinimumSize(100, 35);
-    connect(m_rvizButton, &QPushButton::clicked, this, &FlightControlsLauncher::onLaunchRVIZ);
+    // 为注册表中每个显示按钮的应用程序生成启动按钮
+    int buttonCount = 0;
+    m_applicationButtons.fill(nullptr, m_supervisor->applicationCount());
+    for (int i = 0; i < m_supervisor->applicationCount(); ++i) {
+        const AppDefinition &definition = m_supervisor->definition(i);
+        if (!definition.showButton) {
+            continue;
+        }
+        
+        QPushButton *button = new QPushButton(QString("%1 启动 %2").arg(definition.icon, definition.label), this);
+        button->setMinimumSize(BUTTON_MIN_WIDTH, 35);
+        connect(button, &QPushButton::clicked, this, [this, i]() {
+            onApplicationButtonClicked(i);
+        });
+        m_buttonLayout->addWidget(button);
+        m_applicationButtons[i] = button;
+        buttonCount++;
+    }
+    
+    // 每个启动配置一个按钮，一次启动/停止其中的所有应用程序
+    const QVector<LaunchProfile> &profiles = m_supervisor->profiles();
+    for (int i = 0; i < profiles.size(); ++i) {
+        const LaunchProfile &profile = profiles[i];
+        QPushButton *button = new QPushButton(QString("%1 启动 %2").arg(profile.icon, profile.label), this);
+        button->setMinimumSize(BUTTON_MIN_WIDTH, 35);
+        button->setToolTip(QString("同时启动: %1（有依赖的在依赖就绪后启动）").arg(profile.applications.join(", ")));
+        connect(button, &QPushButton::clicked, this, [this, i]() {
+            onProfileButtonClicked(i);
+        });
+        m_buttonLayout->addWidget(button);
+        m_profileButtons.append(button);
+        buttonCount++;
+    }
     
     // 关闭按钮 - 修改为清理所有应用程序
     m_closeButton = new QPushButton("✖", this);
     m_closeButton->setFixedSize(25, 25);
-    m_closeButton->setToolTip("关闭启动器并停止所有应用程序");
+    m_closeButton->setToolTip(m_supervisor->isAttachedToDaemon()
+        ? "关闭启动器（应用程序继续由监管守护进程运行）" : "关闭启动器并停止所有应用程序");
     connect(m_closeButton, &QPushButton::clicked, this, &FlightControlsLauncher::onCloseButtonClicked);
     
     // 状态标签
@@ -609,12 +527,14 @@ void FlightControlsLauncher::setupButtons()
     m_statusLabel->setAlignment(Qt::AlignCenter);
     
     // 添加到布局
-    m_buttonLayout->addWidget(m_qgcButton);
-    m_buttonLayout->addWidget(m_rvizButton);
     m_buttonLayout->addStretch();
     m_buttonLayout->addWidget(m_closeButton);
     
     m_statusLayout->addWidget(m_statusLabel);
+    
+    // 按钮较多时加宽启动器（按钮最小宽度 + 间距，再加上边距和关闭按钮）
+    setFixedSize(qMax(LAUNCHER_WIDTH, buttonCount * (BUTTON_MIN_WIDTH + 15) + 90) + 2 * m_shadowMargin,
+                 LAUNCHER_HEIGHT + 2 * m_shadowMargin);
 }
 
 void FlightControlsLauncher::positionWindow()
@@ -624,80 +544,68 @@ void FlightControlsLauncher::positionWindow()
     if (screen) {
         QRect screenGeometry = screen->geometry();
         
-        // 计算居中位置（屏幕顶部，水平居中）
+        // 计算居中位置（屏幕顶部，水平居中），阴影边距不计入偏移
         int x = (screenGeometry.width() - width()) / 2;
-        int y = TOP_OFFSET;
+        int y = TOP_OFFSET - m_shadowMargin;
         
         move(x, y);
         qDebug() << "启动器位置:" << x << "," << y;
     } else {
         qWarning() << "无法获取主屏幕信息，使用默认位置";
-        move(100, TOP_OFFSET);
+        move(100, TOP_OFFSET - m_shadowMargin);
+    }
+}
+
+namespace {
+    QString buttonStyleSheet(const QString &colorName)
+    {
+        QColor color(colorName);
+        if (!color.isValid()) {
+            color = QColor("#607D8B");
+        }
+        
+        return QString(
+            "QPushButton {"
+            "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
+            "        stop: 0 %1, stop: 1 %2);"
+            "    color: white;"
+            "    border: none;"
+            "    border-radius: 8px;"
+            "    font-weight: bold;"
+            "    font-size: 11px;"
+            "    padding: 5px;"
+            "}"
+            "QPushButton:hover {"
+            "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
+            "        stop: 0 %2, stop: 1 %3);"
+            "}"
+            "QPushButton:pressed {"
+            "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
+            "        stop: 0 %3, stop: 1 %4);"
+            "}"
+            "QPushButton:disabled {"
+            "    background: #cccccc;"
+            "    color: #666666;"
+            "}"
+        ).arg(color.name(), color.darker(110).name(), color.darker(125).name(), color.darker(140).name());
     }
 }
 
 void FlightControlsLauncher::applyStyles()
 {
-    // 设置主窗口样式
-    setStyleSheet(
-        "FlightControlsLauncher {"
-        "    background-color: rgba(45, 52, 65, 0.95);"
-        "    border-radius: 15px;"
-        "    border: 2px solid rgba(255, 255, 255, 0.3);"
-        "}"
-    );
-    
-    // QGC按钮样式
-    m_qgcButton->setStyleSheet(
-        "QPushButton {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #4CAF50, stop: 1 #45a049);"
-        "    color: white;"
-        "    border: none;"
-        "    border-radius: 8px;"
-        "    font-weight: bold;"
-        "    font-size: 11px;"
-        "    padding: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #45a049, stop: 1 #3d8b40);"
-        "}"
-        "QPushButton:pressed {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #3d8b40, stop: 1 #357a38);"
-        "}"
-        "QPushButton:disabled {"
-        "    background: #cccccc;"
-        "    color: #666666;"
-        "}"
-    );
-    
-    // RVIZ按钮样式
-    m_rvizButton->setStyleSheet(
-        "QPushButton {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #2196F3, stop: 1 #1976D2);"
-        "    color: white;"
-        "    border: none;"
-        "    border-radius: 8px;"
-        "    font-weight: bold;"
-        "    font-size: 11px;"
-        "    padding: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #1976D2, stop: 1 #1565C0);"
-        "}"
-        "QPushButton:pressed {"
-        "    background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,"
-        "        stop: 0 #1565C0, stop: 1 #0d47a1);"
-        "}"
-        "QPushButton:disabled {"
-        "    background: #cccccc;"
-        "    color: #666666;"
-        "}"
-    );
+    // 主窗口背景和阴影不使用样式表和QGraphicsDropShadowEffect：
+    // 二者在每次子控件更新和拖动时都会重新模糊整个半透明窗口，改为预渲染后在paintEvent中贴图
+    m_background = QPixmap();
+    
+    // 应用程序和启动配置按钮样式：渐变色由注册表中的主色逐级加深得到
+    for (int i = 0; i < m_applicationButtons.size(); ++i) {
+        if (m_applicationButtons[i]) {
+            m_applicationButtons[i]->setStyleSheet(buttonStyleSheet(m_supervisor->definition(i).color));
+        }
+    }
+    for (int i = 0; i < m_profileButtons.size(); ++i) {
+        m_profileButtons[i]->setStyleSheet(buttonStyleSheet(m_supervisor->profiles()[i].color));
+    }
     
     // 关闭按钮样式
     m_closeButton->setStyleSheet(
@@ -725,20 +633,127 @@ void FlightControlsLauncher::applyStyles()
         "    border-radius: 10px;"
         "}"
     );
+}
+
+void FlightControlsLauncher::renderBackground()
+{
+    StartupTrace::Scope trace("renderBackground");
+    
+    // 在设备像素中渲染，高分屏上不会模糊
+    const qreal ratio = devicePixelRatioF();
+    QImage image(size() * ratio, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    
+    QRectF panel = QRectF(rect()).adjusted(m_shadowMargin, m_shadowMargin, -m_shadowMargin, -m_shadowMargin);
+    QPainterPath panelPath;
+    panelPath.addRoundedRect(panel.adjusted(1, 1, -1, -1), CORNER_RADIUS, CORNER_RADIUS);
+    
+    if (m_shadowMargin > 0) {
+        // 阴影：面板形状下移后模糊，只在这里计算一次
+        QImage shape(image.size(), QImage::Format_ARGB32_Premultiplied);
+        shape.fill(Qt::transparent);
+        {
+            QPainter shapePainter(&shape);
+            shapePainter.setRenderHint(QPainter::Antialiasing);
+            shapePainter.scale(ratio, ratio);
+            shapePainter.translate(0, SHADOW_OFFSET_Y);
+            shapePainter.fillPath(panelPath, QColor(0, 0, 0, 160));
+        }
+        
+        QGraphicsScene scene;
+        scene.setSceneRect(shape.rect());
+        QGraphicsPixmapItem *item = scene.addPixmap(QPixmap::fromImage(shape));
+        QGraphicsBlurEffect *blur = new QGraphicsBlurEffect;
+        blur->setBlurRadius(SHADOW_BLUR_RADIUS * ratio);
+        blur->setBlurHints(QGraphicsBlurEffect::QualityHint);
+        item->setGraphicsEffect(blur);
+        
+        QPainter shadowPainter(&image);
+        scene.render(&shadowPainter, QRectF(image.rect()), QRectF(image.rect()));
+    }
+    
+    // 面板背景和边框
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(ratio, ratio);
+    painter.fillPath(panelPath, QColor(45, 52, 65, 242));
+    painter.setPen(QPen(QColor(255, 255, 255, 77), 2));
+    painter.drawPath(panelPath);
+    painter.end();
     
-    // 添加阴影效果
-    QGraphicsDropShadowEffect *shadowEffect = new QGraphicsDropShadowEffect(this);
-    shadowEffect->setColor(QColor(0, 0, 0, 160));
-    shadowEffect->setBlurRadius(20);
-    shadowEffect->setOffset(0, 5);
-    setGraphicsEffect(shadowEffect);
+    image.setDevicePixelRatio(ratio);
+    m_background = QPixmap::fromImage(image);
+}
+
+void FlightControlsLauncher::paintEvent(QPaintEvent *event)
+{
+    if (m_background.isNull() || m_background.devicePixelRatio() != devicePixelRatioF()) {
+        renderBackground();
+    }
+    
+    // 子控件更新和窗口移动时只需把缓存贴到需要重绘的区域
+    QPainter painter(this);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.setClipRegion(event->region());
+    painter.drawPixmap(0, 0, m_background);
+}
+
+void FlightControlsLauncher::resizeEvent(QResizeEvent *event)
+{
+    m_background = QPixmap();
+    QWidget::resizeEvent(event);
+}
+
+void FlightControlsLauncher::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::PaletteChange || event->type() == QEvent::StyleChange) {
+        m_background = QPixmap();
+        update();
+    }
+    QWidget::changeEvent(event);
+}
+
+bool FlightControlsLauncher::parseDragMode(const QString &name, DragMode *mode)
+{
+    static const QHash<QString, DragMode> modes = {
+        {"system", DragMode::System}, {"coalesced", DragMode::Coalesced}, {"immediate", DragMode::Immediate}
+    };
+    if (!modes.contains(name)) {
+        return false;
+    }
+    *mode = modes.value(name);
+    return true;
+}
+
+bool FlightControlsLauncher::startSystemMove()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    // 窗口管理器直接移动窗口，拖动期间启动器不处理移动事件也不重绘
+    return windowHandle() && windowHandle()->startSystemMove();
+#else
+    // Qt 5.15之前没有公开接口释放Qt连接上的隐式指针抓取，窗口管理器无法接管
+    return false;
+#endif
+}
+
+int FlightControlsLauncher::dragFrameInterval() const
+{
+    QScreen *screen = windowHandle() ? windowHandle()->screen() : QApplication::primaryScreen();
+    qreal refreshRate = screen ? screen->refreshRate() : 0;
+    return qMax(1, qRound(1000.0 / (refreshRate > 0 ? refreshRate : 60.0)));
 }
 
 void FlightControlsLauncher::mousePressEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
+        if (m_dragMode == DragMode::System && startSystemMove()) {
+            event->accept();
+            return;
+        }
         m_dragging = true;
         m_dragPosition = event->globalPos() - frameGeometry().topLeft();
+        m_dragTarget = pos();
+        m_lastDragMove.invalidate();
         event->accept();
     }
 }
@@ -746,7 +761,19 @@ void FlightControlsLauncher::mousePressEvent(QMouseEvent *event)
 void FlightControlsLauncher::mouseMoveEvent(QMouseEvent *event)
 {
     if (event->buttons() & Qt::LeftButton && m_dragging) {
-        move(event->globalPos() - m_dragPosition);
+        m_dragTarget = event->globalPos() - m_dragPosition;
+        if (m_dragMode == DragMode::Immediate) {
+            move(m_dragTarget);
+        } else if (!m_dragTimer->isActive()) {
+            // 距上次移动已满一帧时立即移动，否则在下一帧应用最新位置
+            int interval = dragFrameInterval();
+            qint64 elapsed = m_lastDragMove.isValid() ? m_lastDragMove.elapsed() : interval;
+            if (elapsed >= interval) {
+                applyPendingDrag();
+            } else {
+                m_dragTimer->start(static_cast<int>(interval - elapsed));
+            }
+        }
         event->accept();
     }
 }
@@ -754,279 +781,110 @@ void FlightControlsLauncher::mouseMoveEvent(QMouseEvent *event)
 void FlightControlsLauncher::mouseReleaseEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
+        if (m_dragging) {
+            m_dragTimer->stop();
+            applyPendingDrag();
+        }
         m_dragging = false;
         event->accept();
     }
 }
 
-void FlightControlsLauncher::startApplication(const QString &appName, const QString &command, const QStringList &args)
+void FlightControlsLauncher::applyPendingDrag()
 {
-    if (!m_applications.contains(appName)) {
-        qWarning() << "应用程序未注册:" << appName;
-        QMessageBox::warning(this, "启动错误", QString("应用程序 %1 未注册").arg(appName));
-        return;
-    }
-    
-    AppProcess &app = m_applications[appName];
-    
-    if (app.isRunning && app.process && app.process->state() == QProcess::Running) {
-        qDebug() << appName << "已在运行中";
-        return;
-    }
-    
-    // 清理之前的进程实例
-    if (app.process) {
-        if (app.process->state() != QProcess::NotRunning) {
-            qDebug() << "终止之前的" << appName << "进程";
-            app.process->kill();
-            app.process->waitForFinished(PROCESS_KILL_TIMEOUT);
-        }
-        app.process->deleteLater();
-        app.process = nullptr;
-    }
-    
-    // 设置命令和参数
-    QString actualCommand = command.isEmpty() ? app.command : command;
-    QStringList actualArgs = args.isEmpty() ? app.arguments : args;
-    
-    qDebug() << "启动" << appName << ":" << actualCommand << actualArgs;
-    
-    // 对于RVIZ，使用startDetached直接启动终端，不需要QProcess管理
-    if (appName == "RVIZ") {
-        bool success = QProcess::startDetached(actualCommand, actualArgs);
-        if (success) {
-            app.isRunning = true;
-            qDebug() << appName << "终端启动成功";
-            updateStatus();
-            
-            // 启动窗口搜索定时器
-            m_windowSearchTimer->start(WINDOW_SEARCH_DELAY);
-        } else {
-            QString errorMsg = QString("启动 %1 失败").arg(appName);
-            qWarning() << errorMsg;
-            QMessageBox::warning(this, "启动失败", 
-                errorMsg + "\n\n提示：\n" +
-                "- 请确保系统安装了终端程序（gnome-terminal、konsole、xfce4-terminal或xterm）\n" +
-                "- 请确保ROS环境已正确配置\n" +
-                "- 可以尝试在终端中手动执行：roscore& rosrun rviz rviz\n\n" +
-                "当前使用的终端：" + actualCommand);
-        }
-        return;
-    }
-    
-    // 对于其他应用程序，使用正常的QProcess管理
-    app.process = new QProcess(this);
-    // Qt 5.9兼容的信号连接方式
-    connect(app.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-            this, &FlightControlsLauncher::onProcessFinished);
-    
-    // 设置进程环境 - 继承系统环境变量
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    app.process->setProcessEnvironment(env);
-    
-    // 启动进程
-    app.process->start(actualCommand, actualArgs);
-    
-    if (!app.process->waitForStarted(5000)) {
-        QString errorMsg = QString("启动 %1 失败: %2").arg(appName).arg(app.process->errorString());
-        qWarning() << errorMsg;
-        QMessageBox::warning(this, "启动失败", errorMsg);
-        
-        // 清理失败的进程
-        app.process->deleteLater();
-        app.process = nullptr;
-        return;
-    }
-    
-    app.isRunning = true;
-    qDebug() << appName << "启动成功，PID:" << app.process->processId();
-    
-    updateStatus();
-    
-    // 重置重试计数器，准备新的窗口搜索
-    m_searchRetryCount = 0;
-    
-    // 启动窗口搜索定时器 - RVIZ需要更长的延迟
-    int searchDelay = WINDOW_SEARCH_DELAY;
-    if (appName == "RVIZ") {
-        searchDelay = WINDOW_SEARCH_DELAY + RVIZ_EXTRA_DELAY; // RVIZ额外等待5秒，总共10秒
-        qDebug() << "RVIZ需要更长的启动时间，将在" << searchDelay << "毫秒后开始搜索窗口...";
-    } else {
-        qDebug() << "将在" << searchDelay << "毫秒后开始搜索窗口...";
+    if (pos() != m_dragTarget) {
+        move(m_dragTarget);
     }
-    m_windowSearchTimer->start(searchDelay);
+    m_lastDragMove.start();
 }
 
-void FlightControlsLauncher::stopApplication(const QString &appName)
+void FlightControlsLauncher::contextMenuEvent(QContextMenuEvent *event)
 {
-    if (!m_applications.contains(appName)) {
-        qWarning() << "尝试停止未注册的应用程序:" << appName;
-        return;
-    }
-    
-    AppProcess &app = m_applications[appName];
-    
-    if (!app.isRunning) {
-        qDebug() << appName << "未在运行";
-        return;
+    QMenu menu(this);
+    menu.addAction("导出资源记录 (CSV)", this, &FlightControlsLauncher::exportResourceHistory);
+    menu.exec(event->globalPos());
+}
+
+QString FlightControlsLauncher::applicationToolTip(int index) const
+{
+    QStringList lines;
+    QString summary = m_supervisor->supervisionSummary(index);
+    if (!summary.isEmpty()) {
+        lines << summary;
     }
-    
-    qDebug() << "停止" << appName;
-    
-    // 对于RVIZ，直接清理ROS进程
-    if (appName == "RVIZ") {
-        // 清理可能的ROS进程
-        QProcess::execute("pkill", QStringList() << "-f" << "roscore");
-        QProcess::execute("pkill", QStringList() << "-f" << "rviz");
-        QProcess::execute("pkill", QStringList() << "-f" << "gnome-terminal.*geometry.*1x1");
-        
-        app.isRunning = false;
-        qDebug() << appName << "已停止";
-        updateStatus();
-        return;
+    ResourceSample sample;
+    if (m_supervisor->resourceMonitor()->latest(m_supervisor->definition(index).id, &sample)) {
+        lines << ResourceMonitor::describe(sample);
     }
-    
-    // 对于QGC，使用增强的停止机制
-    if (appName == "QGC") {
-        bool processStoppedNormally = false;
-        
-        // 第一步：尝试通过QProcess优雅停止
-        if (app.process) {
-            qint64 pid = app.process->processId();
-            qDebug() << "尝试优雅停止" << appName << "，PID:" << pid;
-            
-            app.process->terminate();
-            if (app.process->waitForFinished(3000)) {
-                qDebug() << appName << "优雅停止成功";
-                processStoppedNormally = true;
-            } else {
-                qWarning() << appName << "优雅终止超时，尝试强制杀死进程";
-                app.process->kill();
-                if (app.process->waitForFinished(2000)) {
-                    qDebug() << appName << "强制停止成功";
-                    processStoppedNormally = true;
-                } else {
-                    qCritical() << appName << "进程可能已僵死，无法通过QProcess停止";
-                }
-            }
-        } else {
-            qDebug() << appName << "没有关联的QProcess，将直接执行系统级清理";
-        }
-        
-        // 第二步：使用pkill确保清理所有QGC相关进程
-        if (processStoppedNormally) {
-            qDebug() << "QProcess停止成功，执行安全性pkill清理...";
-        } else {
-            qDebug() << "QProcess停止失败或不存在，执行强制pkill清理...";
-        }
-        
-        // 清理主QGC进程
-        int result1 = QProcess::execute("pkill", QStringList() << "-f" << "QGroundControl");
-        int result2 = QProcess::execute("pkill", QStringList() << "-f" << "qgroundcontrol");
-        int result3 = QProcess::execute("pkill", QStringList() << "-f" << "QGC");
-        
-        // 清理可能的AppImage进程
-        int result4 = QProcess::execute("pkill", QStringList() << "-f" << ".AppImage");
-        
-        qDebug() << "pkill清理结果:" 
-                << "QGroundControl(" << result1 << ")"
-                << "qgroundcontrol(" << result2 << ")"
-                << "QGC(" << result3 << ")"
-                << ".AppImage(" << result4 << ")";
-        
-        // 第三步：等待时间基于停止方式调整
-        int waitTime = processStoppedNormally ? 500 : 1000; // 正常停止等待时间更短
-        qDebug() << "等待" << waitTime << "毫秒确保进程完全退出...";
-        QThread::msleep(waitTime);
-        
-        // 第四步：验证进程是否真的停止了
-        QProcess checkProcess;
-        checkProcess.start("pgrep", QStringList() << "-f" << "QGroundControl");
-        if (checkProcess.waitForFinished(2000)) {
-            QByteArray output = checkProcess.readAllStandardOutput();
-            if (output.isEmpty()) {
-                qDebug() << "✅ 确认所有QGC进程已完全停止";
-            } else {
-                qWarning() << "⚠️ 检测到残留的QGC进程，PID:" << output.trimmed();
-                // 最后手段：强制杀死残留进程
-                QStringList pids = QString::fromLocal8Bit(output).split('\n', QString::SkipEmptyParts);
-                for (const QString &pid : pids) {
-                    if (!pid.trimmed().isEmpty()) {
-                        qDebug() << "强制杀死残留进程PID:" << pid.trimmed();
-                        QProcess::execute("kill", QStringList() << "-9" << pid.trimmed());
-                    }
-                }
-            }
-        }
-        
-        app.isRunning = false;
-        if (processStoppedNormally) {
-            qDebug() << "🎉" << appName << "正常停止流程完成";
-        } else {
-            qDebug() << "🎉" << appName << "强制停止流程完成";
+    return lines.join("\n");
+}
+
+void FlightControlsLauncher::updateToolTips()
+{
+    for (int i = 0; i < m_applicationButtons.size(); ++i) {
+        QPushButton *button = m_applicationButtons[i];
+        if (!button) {
+            continue;
         }
-        updateStatus();
-        return;
-    }
-    
-    // 对于其他应用程序，使用原有机制
-    if (app.process) {
-        qDebug() << "停止" << appName << "，PID:" << app.process->processId();
-        
-        // 尝试优雅终止
-        app.process->terminate();
-        if (!app.process->waitForFinished(3000)) {
-            qWarning() << appName << "优雅终止超时，强制杀死进程";
-            app.process->kill();
-            app.process->waitForFinished(1000);
+        QString toolTip = applicationToolTip(i);
+        if (button->toolTip() != toolTip) {
+            button->setToolTip(toolTip);
         }
     }
-    
-    app.isRunning = false;
-    qDebug() << appName << "已停止";
-    updateStatus();
 }
 
-bool FlightControlsLauncher::isApplicationRunning(const QString &appName) const
+void FlightControlsLauncher::exportResourceHistory()
 {
-    if (m_applications.contains(appName)) {
-        const AppProcess &app = m_applications[appName];
-        if (appName == "RVIZ") {
-            // 对于RVIZ，检查进程是否仍在运行
-            return app.isRunning;
-        } else {
-            return app.isRunning && app.process && (app.process->state() == QProcess::Running);
-        }
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(directory);
+    QString path = QString("%1/resource_telemetry_%2.csv")
+            .arg(directory, QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    
+    QString error;
+    if (m_supervisor->resourceMonitor()->exportCsv(path, &error)) {
+        qDebug() << "资源记录已导出:" << path;
+        QMessageBox::information(this, "导出资源记录", QString("已导出最近 %1 分钟的资源记录：\n%2")
+                                 .arg(ResourceMonitor::HISTORY_SECONDS / 60).arg(path));
+    } else {
+        qWarning() << "导出资源记录失败:" << error;
+        QMessageBox::warning(this, "导出资源记录", QString("导出失败: %1").arg(error));
     }
-    return false;
 }
 
-void FlightControlsLauncher::onLaunchQGC()
+void FlightControlsLauncher::onApplicationButtonClicked(int index)
 {
-    if (isApplicationRunning("QGC")) {
-        stopApplication("QGC");
+    if (m_supervisor->isApplicationRunning(index)) {
+        m_supervisor->stop(index);
     } else {
-        QString qgcPath = findQGroundControlPath();
-        if (qgcPath.isEmpty()) {
-            QMessageBox::warning(this, "启动失败", 
-                "未找到QGroundControl.AppImage文件！\n\n"
-                "请确保QGroundControl.AppImage文件在以下位置之一：\n"
-                "• 当前工作目录\n"
-                "• 程序所在目录\n"
-                "• ./build/ 目录");
-            return;
-        }
-        startApplication("QGC", qgcPath);
+        m_supervisor->start(index);
     }
 }
 
-void FlightControlsLauncher::onLaunchRVIZ()
+void FlightControlsLauncher::onLaunchFailed(int index, const QString &message)
+{
+    Q_UNUSED(index)
+    QMessageBox::warning(this, "启动失败", message);
+}
+
+void FlightControlsLauncher::onRestartAbandoned(int index, const QString &reason)
 {
-    if (isApplicationRunning("RVIZ")) {
-        stopApplication("RVIZ");
+    Q_UNUSED(index)
+    QMessageBox::warning(this, "自动重启已停止", reason);
+}
+
+void FlightControlsLauncher::activate()
+{
+    show();
+    raise();
+    activateWindow();
+}
+
+void FlightControlsLauncher::onProfileButtonClicked(int profileIndex)
+{
+    if (m_supervisor->isProfileRunning(profileIndex)) {
+        m_supervisor->stopProfile(profileIndex);
     } else {
-        // 使用终端窗口启动RVIZ
-        startApplication("RVIZ", "", QStringList());
+        m_supervisor->startProfile(m_supervisor->profiles()[profileIndex].id);
     }
 }
 
@@ -1034,74 +892,101 @@ void FlightControlsLauncher::onCloseButtonClicked()
 {
     qDebug() << "关闭按钮被点击，停止所有应用程序并关闭启动器";
     
-    // 停止所有应用程序
-    stopAllApplications();
-    
-    // 关闭启动器
-    close();
-}
-
-void FlightControlsLauncher::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
-{
-    QProcess *process = qobject_cast<QProcess*>(sender());
-    if (!process) {
-        qWarning() << "进程结束信号发送者无效";
+    if (m_closeRequested) {
         return;
     }
+    m_closeRequested = true;
     
-    // 查找对应的应用程序
-    QString appName;
-    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
-        if (it.value().process == process) {
-            appName = it.key();
-            AppProcess &app = it.value();
-            
-            QString statusText = (exitStatus == QProcess::NormalExit) ? "正常退出" : "异常终止";
-            qDebug() << appName << "进程结束 -" << statusText << "，退出代码:" << exitCode;
-            
-            app.isRunning = false;
-            break;
+    // 所有停止流程完成后再关闭启动器，期间界面保持响应
+    connect(m_supervisor, &Supervisor::allApplicationsStopped, this, &QWidget::close);
+    for (QPushButton *button : m_applicationButtons) {
+        if (button) {
+            button->setEnabled(false);
         }
     }
-    
-    if (appName.isEmpty()) {
-        qWarning() << "无法找到对应的应用程序进程";
+    for (QPushButton *button : m_profileButtons) {
+        button->setEnabled(false);
     }
+    m_closeButton->setEnabled(false);
+    m_statusLabel->setText(m_supervisor->isAttachedToDaemon() ? "⏳ 正在关闭..." : "⏳ 正在停止所有应用程序...");
     
-    updateStatus();
+    m_supervisor->shutdown();
+}
+
+namespace {
+    // 按钮和标签带有复杂样式表，setText会触发重新布局和整个半透明窗口重绘，
+    // 因此只在内容真正变化时才更新
+    template <typename Widget>
+    void setTextIfChanged(Widget *widget, const QString &text)
+    {
+        if (widget->text() != text) {
+            widget->setText(text);
+        }
+    }
 }
 
 void FlightControlsLauncher::updateStatus()
 {
-    bool qgcRunning = isApplicationRunning("QGC");
-    bool rvizRunning = isApplicationRunning("RVIZ");
-    
-    // 更新QGC按钮
-    if (qgcRunning) {
-        m_qgcButton->setText("🚁 停止 QGC");
-        m_qgcButton->setEnabled(true);
-    } else {
-        m_qgcButton->setText("🚁 启动 QGC");
-        m_qgcButton->setEnabled(true);
+    // 关闭流程中保持按钮禁用
+    if (m_closeRequested) {
+        return;
     }
     
-    // 更新RVIZ按钮
-    if (rvizRunning) {
-        m_rvizButton->setText("🤖 停止 RVIZ");
-        m_rvizButton->setEnabled(true);
-    } else {
-        m_rvizButton->setText("🤖 启动 RVIZ");
-        m_rvizButton->setEnabled(true);
+    bool anyStopping = false;
+    QStringList runningLabels;
+    QStringList restartingLabels;
+    
+    for (int i = 0; i < m_applicationButtons.size(); ++i) {
+        QPushButton *button = m_applicationButtons[i];
+        if (!button) {
+            continue;
+        }
+        
+        // 自动重启过的应用在按钮上显示次数，提示中给出上次退出代码
+        const AppDefinition &definition = m_supervisor->definition(i);
+        int restartCount = m_supervisor->restartCount(i);
+        QString restartBadge = restartCount > 0 ? QString(" ↻%1").arg(restartCount) : QString();
+        bool stopping = m_supervisor->isStopping(i);
+        if (stopping) {
+            setTextIfChanged(button, "⏳ 停止中...");
+            anyStopping = true;
+        } else if (m_supervisor->isRestartScheduled(i)) {
+            setTextIfChanged(button, QString("🔁 取消重启 %1").arg(definition.label));
+            restartingLabels << definition.label;
+        } else if (m_supervisor->isActive(i)) {
+            setTextIfChanged(button, QString("%1 停止 %2%3").arg(definition.icon, definition.label, restartBadge));
+            runningLabels << definition.label;
+        } else {
+            setTextIfChanged(button, QString("%1 启动 %2%3").arg(definition.icon, definition.label, restartBadge));
+        }
+        button->setEnabled(!stopping);
+    }
+    updateToolTips();
+    
+    const QVector<LaunchProfile> &profiles = m_supervisor->profiles();
+    for (int i = 0; i < profiles.size(); ++i) {
+        const LaunchProfile &profile = profiles[i];
+        bool stopping = m_supervisor->isProfileStopping(i);
+        if (stopping) {
+            setTextIfChanged(m_profileButtons[i], "⏳ 停止中...");
+        } else if (m_supervisor->isProfileRunning(i)) {
+            setTextIfChanged(m_profileButtons[i], QString("%1 停止 %2").arg(profile.icon, profile.label));
+        } else {
+            setTextIfChanged(m_profileButtons[i], QString("%1 启动 %2").arg(profile.icon, profile.label));
+        }
+        m_profileButtons[i]->setEnabled(!stopping);
     }
     
     // 更新状态标签
-    if (qgcRunning && rvizRunning) {
-        m_statusLabel->setText("🟡 QGC + RVIZ 运行中");
-    } else if (qgcRunning) {
-        m_statusLabel->setText("🟢 QGC 运行中");
-    } else if (rvizRunning) {
-        m_statusLabel->setText("🔵 RVIZ 运行中");
+    if (anyStopping) {
+        setTextIfChanged(m_statusLabel, "⏳ 正在停止...");
+    } else if (!restartingLabels.isEmpty()) {
+        setTextIfChanged(m_statusLabel, QString("🔁 %1 崩溃，等待重启").arg(restartingLabels.join(" + ")));
+    } else if (runningLabels.size() > 1) {
+        setTextIfChanged(m_statusLabel, QString("🟡 %1 运行中").arg(runningLabels.join(" + ")));
+    } else if (runningLabels.size() == 1) {
+        setTextIfChanged(m_statusLabel, QString("🟢 %1 运行中").arg(runningLabels.first()));
     } else {
-        m_statusLabel->setText("🟢 就绪");
+        setTextIfChanged(m_statusLabel, "🟢 就绪");
     }
-} 
\ No newline at end of file
+}
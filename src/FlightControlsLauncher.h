@@ -6,115 +6,145 @@
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
-#include <QProcess>
-#include <QMap>
 #include <QTimer>
 #include <QMouseEvent>
 #include <QPoint>
-#include <QThread>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
 
-// X11前置声明（避免头文件冲突）
-#ifdef Q_OS_LINUX
-typedef struct _XDisplay Display;
-#endif
+class Supervisor;
+class X11WindowWatcher;
+class X11Service;
+class QContextMenuEvent;
 
 /**
  * @brief 飞行控制应用程序浮动启动器
  * 
- * 提供一个始终置顶的浮动窗口，包含QGroundControl和RVIZ的启动按钮
- * 悬浮显示在屏幕顶部居中位置，提供统一的程序启动界面
+ * 提供一个始终置顶的浮动窗口，为注册表（applications.json）中的每个应用程序和启动配置生成按钮，
+ * 悬浮显示在屏幕顶部居中位置，提供统一的程序启动界面。
+ * 启动、停止和重启由Supervisor完成，启动器只是它的客户端：负责按钮、状态显示和X11窗口管理
  */
 class FlightControlsLauncher : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit FlightControlsLauncher(QWidget *parent = nullptr);
+    explicit FlightControlsLauncher(Supervisor *supervisor, QWidget *parent = nullptr);
     ~FlightControlsLauncher();
+    
+    void activate();             // 显示并置前（第二次运行启动器时）
+    
+    // 拖动方式：由窗口管理器移动（_NET_WM_MOVERESIZE，不支持时回退到合并），
+    // 按屏幕刷新率合并移动事件，或每个事件都移动（用于基准测试对比）
+    enum class DragMode { System, Coalesced, Immediate };
+    void setDragMode(DragMode mode) { m_dragMode = mode; }
+    static bool parseDragMode(const QString &name, DragMode *mode);
 
     // 配置常量
-    static constexpr int LAUNCHER_WIDTH = 360;
+    static constexpr int LAUNCHER_WIDTH = 360;          // 最小宽度，按钮较多时自动加宽
     static constexpr int LAUNCHER_HEIGHT = 100;
     static constexpr int TOP_OFFSET = 50;
-    static constexpr int STATUS_UPDATE_INTERVAL = 2000; // 毫秒
-    static constexpr int PROCESS_KILL_TIMEOUT = 3000;   // 毫秒
-    static constexpr int WINDOW_SEARCH_DELAY = 5000;    // 窗口搜索延迟（增加到5秒）
     static constexpr int WINDOW_SEARCH_RETRY_DELAY = 3000; // 重试延迟（增加到3秒）
     static constexpr int WINDOW_SEARCH_MAX_RETRIES = 5;    // 最大重试次数（增加到5次）
-    static constexpr int RVIZ_EXTRA_DELAY = 5000;         // RVIZ额外延迟（增加到5秒）
+    static constexpr int WINDOW_EVENT_TIMEOUT = 60000;    // 事件驱动模式下等待窗口出现的最长时间
+    static constexpr int BUTTON_MIN_WIDTH = 100;
+    static constexpr int CORNER_RADIUS = 15;
+    static constexpr int SHADOW_MARGIN = 20;            // 阴影所占的透明边距（无合成器时为0）
+    static constexpr int SHADOW_BLUR_RADIUS = 20;
+    static constexpr int SHADOW_OFFSET_Y = 5;
 
 protected:
     // 鼠标事件处理（用于拖拽移动窗口）
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;  // 导出资源记录
+    
+    // 背景和阴影预渲染到m_background，绘制只是贴图
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void changeEvent(QEvent *event) override;
 
 private slots:
-    void onLaunchQGC();
-    void onLaunchRVIZ();
-    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void applyPendingDrag();      // 把窗口移动到最新的拖动位置
+    void onApplicationButtonClicked(int index);
+    void onProfileButtonClicked(int profileIndex);
     void updateStatus();
     void onCloseButtonClicked();  // 关闭按钮槽函数
-    void findAndMaximizeWindows(); // 查找并最大化窗口
-    void retryWindowSearch();     // 重试窗口搜索
+    void findAndMaximizeWindows(); // 为到期的应用查找并最大化窗口（定时轮询模式）
+    void onWindowEvent();         // X11窗口事件到达（事件驱动模式）
+    void checkPendingWindows();   // 为等待窗口的应用程序查找并最大化窗口
+    void onWindowEventTimeout();  // 事件驱动模式：结束已超过截止时间的等待
+    void onLaunchFailed(int index, const QString &message);
+    void onRestartAbandoned(int index, const QString &reason);
 
 private:
     void setupUI();
     void setupButtons();
     void positionWindow();
     
-    // 应用程序管理
-    void startApplication(const QString &appName, const QString &command, const QStringList &args = QStringList());
-    void stopApplication(const QString &appName);
-    void stopAllApplications();  // 停止所有应用程序
-    bool isApplicationRunning(const QString &appName) const;
-    
-    // QGC特殊处理
-    QString findQGroundControlPath();
+    // 按钮提示：重启信息 + 最近一次资源采样
+    QString applicationToolTip(int index) const;
+    void updateToolTips();
+    void exportResourceHistory();
     
-    // 窗口管理
-    void maximizeAndRaiseWindow(const QString &appName);
-    unsigned long findWindowByTitle(const QString &titlePattern);
-    void setWindowMaximized(unsigned long windowId);
-    void raiseWindow(unsigned long windowId);
+    // 窗口管理（Supervisor请求后查找窗口，找到后通知就绪）
+    unsigned long findApplicationWindow(int index);  // 按进程绑定，标题匹配兜底
+    unsigned long findWindowByTitle(const QStringList &titlePatterns);
+    void scheduleWindowSearch(int index);
+    void rearmWindowTimer();            // 按最早到期的等待应用启动共用的定时器
+    void onApplicationWindowFound(int index, unsigned long windowId);  // 就绪通知、最大化并置前
+    void onWindowMaximized(int index);  // 记录启动完成
     
     // UI组件
     QVBoxLayout *m_mainLayout;
     QHBoxLayout *m_buttonLayout;
     QHBoxLayout *m_statusLayout;
     
-    QPushButton *m_qgcButton;
-    QPushButton *m_rvizButton;
     QPushButton *m_closeButton;
     QLabel *m_statusLabel;
     
-    // 应用程序进程管理
-    struct AppProcess {
-        QString name;
-        QString command;
-        QStringList arguments;
-        QProcess *process;
-        bool isRunning;
-        QString windowTitlePattern;  // 窗口标题匹配模式
+    Supervisor *m_supervisor;
+    QVector<QPushButton*> m_applicationButtons;   // 与注册表下标一一对应，不显示按钮的应用（如roscore）为nullptr
+    QVector<QPushButton*> m_profileButtons;       // 与Supervisor::profiles()一一对应
+    QTimer *m_windowSearchTimer;  // 定时轮询模式：下一次到期的搜索
+    
+    // 等待窗口出现的应用程序，各自计时（后启动的应用不影响先启动的截止时间和重试）
+    struct PendingWindow {
+        qint64 due = 0;           // 事件驱动模式为等待截止时间，轮询模式为下一次搜索时间（m_windowClock毫秒）
+        int retryCount = 0;       // 轮询模式已重试的次数
     };
+    QHash<int, PendingWindow> m_pendingWindows;
+    QElapsedTimer m_windowClock;
+    
+    // 事件驱动的窗口发现
+    X11WindowWatcher *m_windowWatcher;   // 根窗口事件监听（不可用时回退到定时轮询）
+    QTimer *m_windowEventTimer;          // 合并同一批X事件的零延迟定时器
+    QTimer *m_windowEventTimeoutTimer;   // 最早的等待截止时间
     
-    QMap<QString, AppProcess> m_applications;
-    QTimer *m_statusTimer;
-    QTimer *m_windowSearchTimer;  // 窗口搜索定时器
-    QTimer *m_retryTimer;         // 重试定时器
-    int m_searchRetryCount;       // 当前重试次数
+    bool m_closeRequested;        // 停止完成后关闭启动器
     
     // 窗口拖拽
     bool m_dragging;
     QPoint m_dragPosition;
+    QPoint m_dragTarget;           // 尚未应用的窗口位置
+    DragMode m_dragMode;
+    QTimer *m_dragTimer;           // 同一帧内的移动事件只应用最后一个
+    QElapsedTimer m_lastDragMove;
+    bool startSystemMove();
+    int dragFrameInterval() const; // 屏幕刷新周期（毫秒）
     
-    // X11显示连接（使用前置声明）
-#ifdef Q_OS_LINUX
-    Display *m_display;
-#endif
+    // X11连接和原子缓存，窗口监听和窗口操作共用
+    X11Service *m_x11;
     
     // 样式设置
     void applyStyles();
+    void renderBackground();       // 尺寸、设备像素比或主题变化时重新渲染
+    
+    QPixmap m_background;          // 预渲染的圆角背景、边框和阴影
+    int m_shadowMargin;
 };
 
 #endif // FLIGHTCONTROLSLAUNCHER_H 
\ No newline at end of file
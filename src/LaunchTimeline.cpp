@@ -0,0 +1,140 @@
+#include "LaunchTimeline.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QDebug>
+
+LaunchTimeline::LaunchTimeline(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QString LaunchTimeline::logPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/launch_timeline.jsonl";
+}
+
+void LaunchTimeline::begin(const QString &appName)
+{
+    Launch launch;
+    launch.startedAt = QDateTime::currentDateTime();
+    launch.clock.start();
+    launch.marks.append({"click", 0.0});
+    m_active.insert(appName, launch);
+}
+
+void LaunchTimeline::mark(const QString &appName, const char *phase)
+{
+    auto it = m_active.find(appName);
+    if (it == m_active.end()) {
+        return;
+    }
+
+    for (const Mark &existing : it.value().marks) {
+        if (existing.phase == QLatin1String(phase)) {
+            return;
+        }
+    }
+
+    double elapsedMs = it.value().clock.nsecsElapsed() / 1000000.0;
+    it.value().marks.append({QString::fromLatin1(phase), elapsedMs});
+    qDebug() << "⏱" << appName << phase << QString::number(elapsedMs, 'f', 1) << "毫秒";
+}
+
+void LaunchTimeline::finish(const QString &appName, const QString &outcome)
+{
+    auto it = m_active.find(appName);
+    if (it == m_active.end()) {
+        return;
+    }
+
+    Launch launch = it.value();
+    m_active.erase(it);
+    launch.outcome = outcome;
+    launch.marks.append({"finish", launch.clock.nsecsElapsed() / 1000000.0});
+
+    appendToLog(appName, launch);
+    m_completed.insert(appName, launch);
+
+    qDebug() << "⏱" << describe(appName, launch);
+    emit summaryChanged(summary());
+}
+
+void LaunchTimeline::appendToLog(const QString &appName, const Launch &launch) const
+{
+    QString path = logPath();
+
+    // 滚动日志：超过上限时保留一份旧文件
+    QFileInfo logInfo(path);
+    if (logInfo.exists() && logInfo.size() > MAX_LOG_SIZE) {
+        QFile::remove(path + ".1");
+        QFile::rename(path, path + ".1");
+    }
+
+    QJsonArray marks;
+    QJsonArray spans;
+    for (int i = 0; i < launch.marks.size(); ++i) {
+        const Mark &mark = launch.marks.at(i);
+        QJsonObject markObject;
+        markObject.insert("phase", mark.phase);
+        markObject.insert("ms", mark.elapsedMs);
+        marks.append(markObject);
+
+        if (i > 0) {
+            const Mark &previous = launch.marks.at(i - 1);
+            QJsonObject span;
+            span.insert("name", previous.phase + "->" + mark.phase);
+            span.insert("ms", mark.elapsedMs - previous.elapsedMs);
+            spans.append(span);
+        }
+    }
+
+    QJsonObject record;
+    record.insert("time", launch.startedAt.toString(Qt::ISODateWithMs));
+    record.insert("app", appName);
+    record.insert("outcome", launch.outcome);
+    record.insert("total_ms", launch.marks.last().elapsedMs);
+    record.insert("marks", marks);
+    record.insert("spans", spans);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "无法写入启动耗时日志:" << path;
+        return;
+    }
+    file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + "\n");
+}
+
+QString LaunchTimeline::describe(const QString &appName, const Launch &launch)
+{
+    QStringList parts;
+    for (int i = 1; i < launch.marks.size() - 1; ++i) {
+        const Mark &mark = launch.marks.at(i);
+        parts << QString("%1 +%2ms").arg(mark.phase)
+                 .arg(mark.elapsedMs - launch.marks.at(i - 1).elapsedMs, 0, 'f', 0);
+    }
+
+    return QString("%1: 总计 %2 秒（%3）[%4]")
+            .arg(appName)
+            .arg(launch.marks.last().elapsedMs / 1000.0, 0, 'f', 2)
+            .arg(launch.outcome)
+            .arg(parts.join(" → "));
+}
+
+QString LaunchTimeline::summary() const
+{
+    if (m_completed.isEmpty()) {
+        return QString();
+    }
+
+    QStringList lines;
+    lines << "最近一次启动耗时：";
+    for (auto it = m_completed.constBegin(); it != m_completed.constEnd(); ++it) {
+        lines << describe(it.key(), it.value());
+    }
+    lines << QString("详细记录: %1").arg(logPath());
+    return lines.join("\n");
+}
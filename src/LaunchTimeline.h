@@ -0,0 +1,63 @@
+#ifndef LAUNCHTIMELINE_H
+#define LAUNCHTIMELINE_H
+
+#include <QObject>
+#include <QMap>
+#include <QVector>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+/**
+ * @brief 应用程序启动耗时记录
+ *
+ * 每次启动从按钮点击开始计时，依次记录各阶段（进程已启动、窗口出现、窗口最大化等），
+ * 结束时以JSON行追加到AppDataLocation下的滚动日志，并生成状态标签的提示摘要，
+ * 用于定位启动延迟究竟消耗在哪个环节
+ */
+class LaunchTimeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 MAX_LOG_SIZE = 1024 * 1024;  // 超过后滚动为.1文件
+
+    explicit LaunchTimeline(QObject *parent = nullptr);
+
+    // 开始一次新的启动（丢弃该应用未完成的记录）
+    void begin(const QString &appName);
+    // 记录阶段时间点；同一阶段只记录第一次
+    void mark(const QString &appName, const char *phase);
+    // 结束本次启动并写入日志；outcome如"maximized"、"window-timeout"、"failed"
+    void finish(const QString &appName, const QString &outcome);
+
+    bool isActive(const QString &appName) const { return m_active.contains(appName); }
+
+    // 最近一次各应用启动耗时的摘要（用于提示文本）
+    QString summary() const;
+
+    static QString logPath();
+
+signals:
+    void summaryChanged(const QString &summary);
+
+private:
+    struct Mark {
+        QString phase;
+        double elapsedMs;
+    };
+
+    struct Launch {
+        QDateTime startedAt;
+        QElapsedTimer clock;
+        QVector<Mark> marks;
+        QString outcome;
+    };
+
+    void appendToLog(const QString &appName, const Launch &launch) const;
+    static QString describe(const QString &appName, const Launch &launch);
+
+    QMap<QString, Launch> m_active;     // 进行中的启动
+    QMap<QString, Launch> m_completed;  // 各应用最近一次完成的启动
+};
+
+#endif // LAUNCHTIMELINE_H
@@ -0,0 +1,111 @@
+#include "ManagedProcess.h"
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#endif
+
+ManagedProcess::ManagedProcess(QObject *parent)
+    : QProcess(parent)
+    , m_processGroupId(0)
+{
+#ifdef Q_OS_LINUX
+    CPU_ZERO(&m_cpuSet);
+#endif
+#ifdef Q_OS_UNIX
+    // setsid()之后进程ID即为进程组ID
+    connect(this, &QProcess::started, this, [this]() {
+        m_processGroupId = processId();
+        if (!m_policy.isEmpty()) {
+            verifySchedulingPolicy();
+        }
+    });
+#endif
+}
+
+qint64 ManagedProcess::processGroupId() const
+{
+#ifdef Q_OS_UNIX
+    // started信号在事件循环中才发出，在此之前直接使用fork得到的PID（setsid()之后即为进程组ID）
+    return m_processGroupId > 0 ? m_processGroupId : processId();
+#else
+    return 0;
+#endif
+}
+
+void ManagedProcess::setSchedulingPolicy(const SchedulingPolicy &policy)
+{
+    m_policy = policy;
+#ifdef Q_OS_LINUX
+    // cpu_set_t在父进程中构造好，子进程中直接使用
+    CPU_ZERO(&m_cpuSet);
+    for (int cpu : policy.cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &m_cpuSet);
+        }
+    }
+#endif
+}
+
+void ManagedProcess::setupChildProcess()
+{
+    // 注意：此函数在fork之后、exec之前的子进程中执行，只能调用异步信号安全的函数
+#ifdef Q_OS_UNIX
+    ::setsid();
+#endif
+
+#ifdef Q_OS_LINUX
+    // 先加入cgroup，之后的资源占用都计入该组；写入"0"表示当前进程
+    if (!m_policy.cgroupProcsPath.isEmpty()) {
+        int fd = ::open(m_policy.cgroupProcsPath.constData(), O_WRONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ssize_t written = ::write(fd, "0", 1);
+            Q_UNUSED(written)
+            ::close(fd);
+        }
+    }
+    if (!m_policy.cpus.isEmpty()) {
+        ::sched_setaffinity(0, sizeof(m_cpuSet), &m_cpuSet);
+    }
+    if (m_policy.scheduler >= 0) {
+        struct sched_param param;
+        param.sched_priority = m_policy.priority;
+        ::sched_setscheduler(0, m_policy.scheduler, &param);
+    }
+    if (m_policy.setNice) {
+        ::setpriority(PRIO_PROCESS, 0, m_policy.nice);
+    }
+#endif
+}
+
+void ManagedProcess::verifySchedulingPolicy()
+{
+#ifdef Q_OS_LINUX
+    // started在exec成功之后才发出，此时子进程中的设置已经完成
+    pid_t pid = static_cast<pid_t>(processId());
+    if (m_policy.scheduler >= 0) {
+        int scheduler = ::sched_getscheduler(pid);
+        if (scheduler >= 0 && scheduler != m_policy.scheduler) {
+            qWarning() << "调度策略未生效（实时调度需要CAP_SYS_NICE或RLIMIT_RTPRIO），PID:" << pid;
+        }
+    }
+    if (m_policy.setNice) {
+        errno = 0;
+        int nice = ::getpriority(PRIO_PROCESS, static_cast<id_t>(pid));
+        if (errno == 0 && nice != m_policy.nice) {
+            qWarning() << "nice" << m_policy.nice << "未生效（降低nice值需要CAP_SYS_NICE），当前为" << nice << "，PID:" << pid;
+        }
+    }
+    if (!m_policy.cpus.isEmpty()) {
+        cpu_set_t actual;
+        if (::sched_getaffinity(pid, sizeof(actual), &actual) == 0 && !CPU_EQUAL(&actual, &m_cpuSet)) {
+            qWarning() << "CPU亲和性未生效（CPU不存在或不在允许范围内），PID:" << pid;
+        }
+    }
+#endif
+}
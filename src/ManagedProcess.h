@@ -0,0 +1,59 @@
+#ifndef MANAGEDPROCESS_H
+#define MANAGEDPROCESS_H
+
+#include <QProcess>
+#include <QByteArray>
+#include <QList>
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
+/**
+ * @brief 在独立会话/进程组中运行的受管进程
+ *
+ * 子进程在exec之前调用setsid()，进程ID即为进程组ID(PGID)，
+ * 停止时可以用kill(-pgid)直接向整个进程树发送信号，
+ * 不再需要pkill -f扫描整个/proc。
+ * 设置了调度策略时，同样在exec之前于子进程中应用（cgroup、CPU亲和性、调度类、nice），
+ * 应用程序从第一条指令起就受策略约束，不存在启动后再调整的竞争窗口
+ */
+class ManagedProcess : public QProcess
+{
+    Q_OBJECT
+
+public:
+    // 所有字段在父进程中准备好，子进程中只做系统调用
+    struct SchedulingPolicy {
+        bool setNice = false;
+        int nice = 0;
+        int scheduler = -1;              // SCHED_*，-1表示不修改
+        int priority = 0;                // SCHED_FIFO/SCHED_RR的静态优先级
+        QList<int> cpus;                 // CPU亲和性，为空表示不限制
+        QByteArray cgroupProcsPath;      // 非空时加入该cgroup（cgroup.procs的路径）
+
+        bool isEmpty() const { return !setNice && scheduler < 0 && cpus.isEmpty() && cgroupProcsPath.isEmpty(); }
+    };
+
+    explicit ManagedProcess(QObject *parent = nullptr);
+
+    // 进程组ID（启动前为0；start()返回后即可用，主进程退出后仍保留，用于清理残留的子进程）
+    qint64 processGroupId() const;
+
+    // 必须在start()之前调用
+    void setSchedulingPolicy(const SchedulingPolicy &policy);
+
+protected:
+    void setupChildProcess() override;
+
+private:
+    void verifySchedulingPolicy();   // 启动后检查策略是否生效（权限不足时子进程中的调用会静默失败）
+
+    qint64 m_processGroupId;
+    SchedulingPolicy m_policy;
+#ifdef Q_OS_LINUX
+    cpu_set_t m_cpuSet;
+#endif
+};
+
+#endif // MANAGEDPROCESS_H
@@ -0,0 +1,119 @@
+#include "ProcessExitWatcher.h"
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+// 旧版glibc头文件（如Ubuntu 18.04）没有定义该系统调用号
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#endif
+
+ProcessExitWatcher::ProcessExitWatcher(QObject *parent)
+    : QObject(parent)
+    , m_pollTimer(new QTimer(this))
+{
+    m_pollTimer->setInterval(FALLBACK_POLL_INTERVAL);
+    connect(m_pollTimer, &QTimer::timeout, this, &ProcessExitWatcher::pollWatched);
+}
+
+ProcessExitWatcher::~ProcessExitWatcher()
+{
+    const QList<qint64> pids = m_watched.keys();
+    for (qint64 pid : pids) {
+        unwatch(pid);
+    }
+}
+
+void ProcessExitWatcher::watch(qint64 pid)
+{
+    if (pid <= 0 || m_watched.contains(pid)) {
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+    int fd = static_cast<int>(::syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+    if (fd >= 0) {
+        QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, [this, pid]() {
+            notifyExited(pid);
+        });
+        m_watched.insert(pid, notifier);
+        qDebug() << "通过pidfd监视进程退出:" << pid;
+        return;
+    }
+    if (errno == ESRCH) {
+        // 进程已经退出
+        QTimer::singleShot(0, this, [this, pid]() { emit exited(pid); });
+        return;
+    }
+#endif
+
+    // 回退：定时检查
+    m_watched.insert(pid, nullptr);
+    if (!m_pollTimer->isActive()) {
+        m_pollTimer->start();
+    }
+    qDebug() << "pidfd不可用，定时检查进程退出:" << pid;
+}
+
+void ProcessExitWatcher::unwatch(qint64 pid)
+{
+    QSocketNotifier *notifier = m_watched.take(pid);
+    if (notifier) {
+        // 可能在通知器自身的信号中调用，先停用再延迟删除
+        notifier->setEnabled(false);
+#ifdef Q_OS_UNIX
+        ::close(static_cast<int>(notifier->socket()));
+#endif
+        notifier->deleteLater();
+    }
+
+    if (m_pollTimer->isActive()) {
+        bool anyPolled = false;
+        for (auto it = m_watched.constBegin(); it != m_watched.constEnd(); ++it) {
+            if (!it.value()) {
+                anyPolled = true;
+                break;
+            }
+        }
+        if (!anyPolled) {
+            m_pollTimer->stop();
+        }
+    }
+}
+
+void ProcessExitWatcher::pollWatched()
+{
+    QList<qint64> exitedPids;
+    for (auto it = m_watched.constBegin(); it != m_watched.constEnd(); ++it) {
+#ifdef Q_OS_UNIX
+        if (!it.value() && ::kill(static_cast<pid_t>(it.key()), 0) != 0 && errno == ESRCH) {
+            exitedPids << it.key();
+        }
+#endif
+    }
+
+    for (qint64 pid : exitedPids) {
+        notifyExited(pid);
+    }
+}
+
+void ProcessExitWatcher::notifyExited(qint64 pid)
+{
+    if (!m_watched.contains(pid)) {
+        return;
+    }
+
+    unwatch(pid);
+    qDebug() << "被监视的进程已退出:" << pid;
+    emit exited(pid);
+}
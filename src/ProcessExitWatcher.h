@@ -0,0 +1,47 @@
+#ifndef PROCESSEXITWATCHER_H
+#define PROCESSEXITWATCHER_H
+
+#include <QObject>
+#include <QHash>
+
+class QSocketNotifier;
+class QTimer;
+
+/**
+ * @brief 非子进程的退出通知
+ *
+ * 启动器无法通过QProcess跟踪的进程（例如经终端启动的rviz）使用pidfd_open
+ * 获得文件描述符，进程退出时该描述符变为可读，由QSocketNotifier直接唤醒事件循环；
+ * 内核不支持pidfd（Linux 5.3之前）时退回低频的kill(pid, 0)检查，
+ * 且只在有被监视的进程时才运行定时器
+ */
+class ProcessExitWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int FALLBACK_POLL_INTERVAL = 1000;  // 无pidfd时的检查间隔（毫秒）
+
+    explicit ProcessExitWatcher(QObject *parent = nullptr);
+    ~ProcessExitWatcher();
+
+    // 开始监视进程；进程已不存在时立即（异步）发出exited
+    void watch(qint64 pid);
+    void unwatch(qint64 pid);
+
+    bool isWatching(qint64 pid) const { return m_watched.contains(pid); }
+
+signals:
+    void exited(qint64 pid);
+
+private slots:
+    void pollWatched();  // 回退模式：检查被监视的进程是否仍然存在
+
+private:
+    void notifyExited(qint64 pid);
+
+    QHash<qint64, QSocketNotifier *> m_watched;  // 回退模式下通知器为nullptr
+    QTimer *m_pollTimer;
+};
+
+#endif // PROCESSEXITWATCHER_H
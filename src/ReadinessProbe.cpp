@@ -0,0 +1,250 @@
+#include "ReadinessProbe.h"
+#include <QTcpSocket>
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QDebug>
+
+ReadinessProbe::ReadinessProbe(QObject *parent)
+    : QObject(parent)
+    , m_socket(nullptr)
+    , m_retryTimer(nullptr)
+    , m_deadlineTimer(nullptr)
+    , m_fileWatcher(nullptr)
+    , m_kind(Kind::None)
+    , m_port(0)
+    , m_timeout(0)
+    , m_active(false)
+{
+    m_socket = new QTcpSocket(this);
+    connect(m_socket, &QTcpSocket::connected, this, &ReadinessProbe::onConnected);
+    // error信号在Qt 5.15中改名为errorOccurred
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    connect(m_socket, &QAbstractSocket::errorOccurred, this, &ReadinessProbe::onAttemptFailed);
+#else
+    connect(m_socket, static_cast<void(QAbstractSocket::*)(QAbstractSocket::SocketError)>(&QAbstractSocket::error),
+            this, &ReadinessProbe::onAttemptFailed);
+#endif
+
+    m_retryTimer = new QTimer(this);
+    m_retryTimer->setSingleShot(true);
+    connect(m_retryTimer, &QTimer::timeout, this, &ReadinessProbe::attempt);
+
+    // 连接请求可能既不成功也不报错（例如被防火墙丢弃），由总超时兜底
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    connect(m_deadlineTimer, &QTimer::timeout, this, [this]() {
+        if (m_active) {
+            cancel();
+            emit timedOut();
+        }
+    });
+}
+
+void ReadinessProbe::begin(Kind kind, int timeoutMs)
+{
+    cancel();
+
+    m_kind = kind;
+    m_timeout = timeoutMs;
+    m_active = true;
+    m_elapsed.start();
+    m_deadlineTimer->start(timeoutMs > 0 ? timeoutMs : SINGLE_ATTEMPT_TIMEOUT);
+}
+
+void ReadinessProbe::waitForTcpPort(const QString &host, quint16 port, int timeoutMs, int retryIntervalMs)
+{
+    begin(Kind::TcpPort, timeoutMs);
+    m_host = host;
+    m_port = port;
+    m_retryTimer->setInterval(retryIntervalMs);
+    attempt();
+}
+
+void ReadinessProbe::waitForUdpPort(quint16 port, int timeoutMs, int retryIntervalMs)
+{
+    begin(Kind::UdpPort, timeoutMs);
+    m_port = port;
+    m_retryTimer->setInterval(retryIntervalMs);
+    attempt();
+}
+
+void ReadinessProbe::waitForFile(const QString &path, int timeoutMs)
+{
+    begin(Kind::File, timeoutMs);
+    m_path = path;
+    m_retryTimer->setInterval(500);
+    if (checkFile() || !m_active) {
+        return;
+    }
+
+    // 目录已存在时由inotify通知文件创建；否则低频检查，直到目录出现
+    QString directory = QFileInfo(path).absolutePath();
+    if (QFileInfo(directory).isDir()) {
+        if (!m_fileWatcher) {
+            m_fileWatcher = new QFileSystemWatcher(this);
+            connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged, this, &ReadinessProbe::onDirectoryChanged);
+        }
+        m_fileWatcher->addPath(directory);
+    } else {
+        m_retryTimer->start();
+    }
+}
+
+void ReadinessProbe::waitForLogLine(const QRegularExpression &pattern, int timeoutMs)
+{
+    begin(Kind::LogLine, timeoutMs);
+    m_pattern = pattern;
+    m_partialLine.clear();
+}
+
+void ReadinessProbe::waitForEvent(int timeoutMs)
+{
+    begin(Kind::Event, timeoutMs);
+}
+
+void ReadinessProbe::cancel()
+{
+    m_active = false;
+    m_retryTimer->stop();
+    m_deadlineTimer->stop();
+    m_socket->abort();
+    if (m_fileWatcher && !m_fileWatcher->directories().isEmpty()) {
+        m_fileWatcher->removePaths(m_fileWatcher->directories());
+    }
+    m_partialLine.clear();
+}
+
+void ReadinessProbe::feed(const QByteArray &output)
+{
+    if (!m_active || m_kind != Kind::LogLine) {
+        return;
+    }
+
+    // 只对完整的行做匹配，未换行的部分留到下一次
+    m_partialLine += output;
+    int lineEnd;
+    while ((lineEnd = m_partialLine.indexOf('\n')) >= 0) {
+        QString line = QString::fromLocal8Bit(m_partialLine.constData(), lineEnd);
+        m_partialLine.remove(0, lineEnd + 1);
+        if (m_pattern.match(line).hasMatch()) {
+            succeed(QString("日志行 \"%1\"").arg(line.trimmed()));
+            return;
+        }
+    }
+    if (m_partialLine.size() > MAX_LOG_LINE) {
+        m_partialLine.clear();
+    }
+}
+
+void ReadinessProbe::notify()
+{
+    if (m_active && m_kind == Kind::Event) {
+        succeed("事件");
+    }
+}
+
+void ReadinessProbe::succeed(const QString &description)
+{
+    qDebug() << "就绪条件满足:" << description << "耗时" << m_elapsed.elapsed() << "毫秒";
+    cancel();
+    emit ready();
+}
+
+void ReadinessProbe::attempt()
+{
+    if (!m_active) {
+        return;
+    }
+
+    switch (m_kind) {
+    case Kind::TcpPort:
+        m_socket->abort();
+        m_socket->connectToHost(m_host, m_port);
+        break;
+    case Kind::UdpPort:
+        if (isUdpPortBound(m_port)) {
+            succeed(QString("UDP端口 %1 已绑定").arg(m_port));
+        } else {
+            onAttemptFailed();
+        }
+        break;
+    case Kind::File:
+        checkFile();
+        break;
+    default:
+        break;
+    }
+}
+
+void ReadinessProbe::onConnected()
+{
+    if (!m_active) {
+        return;
+    }
+
+    succeed(QString("端口 %1:%2 可连接").arg(m_host).arg(m_port));
+}
+
+void ReadinessProbe::onAttemptFailed()
+{
+    if (!m_active) {
+        return;
+    }
+
+    if (m_timeout == 0 || m_elapsed.elapsed() >= m_timeout) {
+        cancel();
+        emit timedOut();
+        return;
+    }
+
+    m_retryTimer->start();
+}
+
+void ReadinessProbe::onDirectoryChanged()
+{
+    checkFile();
+}
+
+bool ReadinessProbe::checkFile()
+{
+    if (!m_active || m_kind != Kind::File) {
+        return false;
+    }
+
+    if (QFileInfo::exists(m_path)) {
+        succeed(QString("文件 %1 已出现").arg(m_path));
+        return true;
+    }
+
+    // 只检查一次（判断现成实例）时立即给出结果；目录未出现时继续低频检查
+    if (m_timeout == 0) {
+        onAttemptFailed();
+    } else if (!m_fileWatcher || m_fileWatcher->directories().isEmpty()) {
+        m_retryTimer->start();
+    }
+    return false;
+}
+
+bool ReadinessProbe::isUdpPortBound(quint16 port)
+{
+    // /proc/net/udp每行的local_address形如"0100007F:3856"，冒号后为十六进制端口
+    const char *tables[] = {"/proc/net/udp", "/proc/net/udp6"};
+    const QByteArray portSuffix = ":" + QByteArray::number(port, 16).toUpper().rightJustified(4, '0');
+    for (const char *table : tables) {
+        QFile file(table);
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        // /proc文件的大小为0，需要一次读到EOF；第一行为表头
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        for (int i = 1; i < lines.size(); ++i) {
+            const QList<QByteArray> fields = lines.at(i).simplified().split(' ');
+            if (fields.size() > 1 && fields.at(1).endsWith(portSuffix)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,88 @@
+#ifndef READINESSPROBE_H
+#define READINESSPROBE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+class QTcpSocket;
+class QTimer;
+class QFileSystemWatcher;
+
+/**
+ * @brief 应用程序就绪探测
+ *
+ * 等待应用程序声明的就绪条件成立后立即发出ready信号，用于替代“启动后固定延迟”的等待方式：
+ * - TCP端口接受连接（例如ROS master的11311端口）
+ * - UDP端口已被绑定（例如QGC的MAVLink 14550端口，读取/proc/net/udp判断）
+ * - 文件出现（监视所在目录，不轮询）
+ * - 标准输出中出现匹配的日志行（由调用方通过feed()送入输出）
+ * - 外部事件（例如窗口已映射，由调用方调用notify()）
+ * 超时后发出timedOut信号
+ */
+class ReadinessProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Kind {
+        None,
+        TcpPort,
+        UdpPort,
+        File,
+        LogLine,
+        Event
+    };
+
+    explicit ReadinessProbe(QObject *parent = nullptr);
+
+    static constexpr int SINGLE_ATTEMPT_TIMEOUT = 1000;  // 单次探测的最长等待时间（毫秒）
+    static constexpr int MAX_LOG_LINE = 4096;            // 未换行的输出最多缓存的字节数
+
+    // timeoutMs为0时只检查一次，用于判断是否已有现成的实例（仅TCP/UDP端口和文件支持）
+    void waitForTcpPort(const QString &host, quint16 port, int timeoutMs, int retryIntervalMs = 100);
+    void waitForUdpPort(quint16 port, int timeoutMs, int retryIntervalMs = 100);
+    void waitForFile(const QString &path, int timeoutMs);
+    void waitForLogLine(const QRegularExpression &pattern, int timeoutMs);
+    void waitForEvent(int timeoutMs);
+    void cancel();
+
+    // 送入应用程序的输出（LogLine），或通知外部事件已发生（Event）
+    void feed(const QByteArray &output);
+    void notify();
+
+    bool isActive() const { return m_active; }
+    Kind kind() const { return m_kind; }
+
+signals:
+    void ready();
+    void timedOut();
+
+private slots:
+    void attempt();
+    void onConnected();
+    void onAttemptFailed();
+    void onDirectoryChanged();
+
+private:
+    void begin(Kind kind, int timeoutMs);
+    void succeed(const QString &description);
+    bool checkFile();
+    static bool isUdpPortBound(quint16 port);
+
+    QTcpSocket *m_socket;
+    QTimer *m_retryTimer;
+    QTimer *m_deadlineTimer;
+    QFileSystemWatcher *m_fileWatcher;
+    QElapsedTimer m_elapsed;
+    Kind m_kind;
+    QString m_host;
+    quint16 m_port;
+    QString m_path;
+    QRegularExpression m_pattern;
+    QByteArray m_partialLine;
+    int m_timeout;
+    bool m_active;
+};
+
+#endif // READINESSPROBE_H
@@ -0,0 +1,420 @@
+#include "ResourceMonitor.h"
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef Q_OS_LINUX
+    // 把/proc/<pid>/<name>读入调用方提供的缓冲区（以0结尾），失败返回-1（进程可能已退出）
+    int readProcFile(qint64 pid, const char *name, char *buffer, int size)
+    {
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%lld/%s", static_cast<long long>(pid), name);
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return -1;
+        }
+        ssize_t length = ::read(fd, buffer, size - 1);
+        ::close(fd);
+        if (length <= 0) {
+            return -1;
+        }
+        buffer[length] = '\0';
+        return static_cast<int>(length);
+    }
+
+    // 跳过count个以空格分隔的字段
+    const char *skipFields(const char *p, int count)
+    {
+        while (count-- > 0 && p) {
+            p = strchr(p, ' ');
+            if (p) {
+                ++p;
+            }
+        }
+        return p;
+    }
+
+    // /proc/<pid>/io中"key: value"行的值
+    quint64 ioField(const char *buffer, const char *key)
+    {
+        const char *p = strstr(buffer, key);
+        return p ? strtoull(p + strlen(key), nullptr, 10) : 0;
+    }
+#endif
+
+    QString formatBytes(double bytes)
+    {
+        if (bytes >= 1024.0 * 1024.0 * 1024.0) {
+            return QString::number(bytes / (1024.0 * 1024.0 * 1024.0), 'f', 1) + " GB";
+        }
+        if (bytes >= 1024.0 * 1024.0) {
+            return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+        }
+        return QString::number(bytes / 1024.0, 'f', 0) + " KB";
+    }
+}
+
+void ResourceHistory::append(const ResourceSample &sample)
+{
+    if (m_samples.isEmpty()) {
+        return;
+    }
+
+    if (m_size < m_samples.size()) {
+        m_samples[(m_head + m_size) % m_samples.size()] = sample;
+        ++m_size;
+    } else {
+        m_samples[m_head] = sample;
+        m_head = (m_head + 1) % m_samples.size();
+    }
+}
+
+ResourceSampler::ResourceSampler(QMutex *mutex, const QVector<ResourceTarget> *targets)
+    : QObject(nullptr)
+    , m_mutex(mutex)
+    , m_targets(targets)
+    , m_timer(nullptr)
+    , m_clockTicks(100)
+    , m_pageSize(4096)
+#ifdef Q_OS_LINUX
+    , m_procDirectory(nullptr)
+#endif
+{
+#ifdef Q_OS_LINUX
+    m_clockTicks = sysconf(_SC_CLK_TCK);
+    m_pageSize = sysconf(_SC_PAGESIZE);
+#endif
+    m_processes.reserve(1024);
+}
+
+ResourceSampler::~ResourceSampler()
+{
+#ifdef Q_OS_LINUX
+    if (m_procDirectory) {
+        closedir(m_procDirectory);
+    }
+#endif
+}
+
+void ResourceSampler::setActive(bool active)
+{
+    // 定时器必须在采样线程中创建
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setInterval(ResourceMonitor::SAMPLE_INTERVAL);
+        connect(m_timer, &QTimer::timeout, this, &ResourceSampler::sample);
+    }
+
+    if (active && !m_timer->isActive()) {
+        m_timer->start();
+        sample();
+    } else if (!active) {
+        m_timer->stop();
+        m_previous.clear();
+    }
+}
+
+void ResourceSampler::sample()
+{
+#ifdef Q_OS_LINUX
+    // 只复制隐式共享的引用，不阻塞界面线程
+    QVector<ResourceTarget> targets;
+    {
+        QMutexLocker locker(m_mutex);
+        targets = *m_targets;
+    }
+    if (targets.isEmpty()) {
+        return;
+    }
+
+    scanProcesses(targets);
+    assignDescendants(targets);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QVector<ResourceSample> samples(targets.size());
+    QVector<Totals> totals(targets.size());
+    char buffer[512];
+
+    for (const ProcessEntry &entry : m_processes) {
+        if (entry.target < 0) {
+            continue;
+        }
+        ResourceSample &sample = samples[entry.target];
+        Totals &total = totals[entry.target];
+        sample.processCount++;
+        total.cpuTicks += entry.cpuTicks;
+
+        // statm第二个字段为常驻内存页数
+        if (readProcFile(entry.pid, "statm", buffer, sizeof(buffer)) > 0) {
+            const char *resident = skipFields(buffer, 1);
+            if (resident) {
+                sample.rssBytes += static_cast<qint64>(strtoull(resident, nullptr, 10)) * m_pageSize;
+            }
+        }
+        // io只对同一用户的进程可读，读不到时只缺少IO数据
+        if (readProcFile(entry.pid, "io", buffer, sizeof(buffer)) > 0) {
+            total.readBytes += ioField(buffer, "read_bytes: ");
+            total.writeBytes += ioField(buffer, "write_bytes: ");
+        }
+    }
+
+    QStringList appIds;
+    for (int i = 0; i < targets.size(); ++i) {
+        const QString &appId = targets[i].appId;
+        ResourceSample &sample = samples[i];
+        Totals &total = totals[i];
+        sample.timestamp = now;
+        total.timestamp = now;
+        appIds << appId;
+
+        // 与上一次采样的差值计算速率；子进程退出会使累计值变小，此时按0处理
+        auto previous = m_previous.constFind(appId);
+        if (previous != m_previous.constEnd() && now > previous->timestamp) {
+            double seconds = (now - previous->timestamp) / 1000.0;
+            if (total.cpuTicks > previous->cpuTicks) {
+                sample.cpuPercent = (total.cpuTicks - previous->cpuTicks) * 100.0 / m_clockTicks / seconds;
+            }
+            if (total.readBytes > previous->readBytes) {
+                sample.readBytesPerSec = static_cast<qint64>((total.readBytes - previous->readBytes) / seconds);
+            }
+            if (total.writeBytes > previous->writeBytes) {
+                sample.writeBytesPerSec = static_cast<qint64>((total.writeBytes - previous->writeBytes) / seconds);
+            }
+        }
+        m_previous.insert(appId, total);
+    }
+
+    // 清理已不再跟踪的应用
+    if (m_previous.size() > targets.size()) {
+        for (auto it = m_previous.begin(); it != m_previous.end();) {
+            it = appIds.contains(it.key()) ? it + 1 : m_previous.erase(it);
+        }
+    }
+
+    emit sampled(samples, appIds);
+#endif
+}
+
+void ResourceSampler::scanProcesses(const QVector<ResourceTarget> &targets)
+{
+#ifdef Q_OS_LINUX
+    m_processes.clear();  // 保留容量
+
+    if (!m_procDirectory) {
+        m_procDirectory = opendir("/proc");
+        if (!m_procDirectory) {
+            qWarning() << "无法打开/proc，资源监控不可用";
+            return;
+        }
+    } else {
+        rewinddir(m_procDirectory);
+    }
+
+    char buffer[1024];
+    while (struct dirent *entry = readdir(m_procDirectory)) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+            continue;
+        }
+        qint64 pid = strtoll(entry->d_name, nullptr, 10);
+        if (readProcFile(pid, "stat", buffer, sizeof(buffer)) <= 0) {
+            continue;
+        }
+
+        // 进程名可能包含空格和括号，从最后一个')'之后开始解析：
+        // state(3) ppid(4) pgrp(5) ... utime(14) stime(15)
+        const char *fields = strrchr(buffer, ')');
+        if (!fields || !(fields = skipFields(fields, 1))) {
+            continue;
+        }
+        const char *parentField = skipFields(fields, 1);
+        const char *groupField = skipFields(parentField, 1);
+        const char *userTimeField = skipFields(groupField, 9);
+        const char *systemTimeField = skipFields(userTimeField, 1);
+        if (!systemTimeField) {
+            continue;
+        }
+
+        ProcessEntry process;
+        process.pid = pid;
+        process.parentPid = strtoll(parentField, nullptr, 10);
+        process.processGroupId = strtoll(groupField, nullptr, 10);
+        process.cpuTicks = strtoull(userTimeField, nullptr, 10) + strtoull(systemTimeField, nullptr, 10);
+        process.target = -1;
+        for (int i = 0; i < targets.size(); ++i) {
+            // 进程组0属于内核线程，不能匹配未记录进程组的应用
+            if (pid == targets[i].rootPid
+                || (process.processGroupId > 0 && targets[i].processGroupIds.contains(process.processGroupId))) {
+                process.target = i;
+                break;
+            }
+        }
+        m_processes.push_back(process);
+    }
+
+    // 按PID排序，便于查找父进程
+    std::sort(m_processes.begin(), m_processes.end(),
+              [](const ProcessEntry &a, const ProcessEntry &b) { return a.pid < b.pid; });
+#else
+    Q_UNUSED(targets)
+#endif
+}
+
+void ResourceSampler::assignDescendants(const QVector<ResourceTarget> &targets)
+{
+    // 自行调用setsid的子进程不在原进程组中，沿父进程链归属到rootPid所在的应用。
+    // 子进程的PID通常大于父进程，按PID顺序一遍即可解析大多数进程链，其余情况再迭代
+    bool hasRootPid = false;
+    for (const ResourceTarget &target : targets) {
+        hasRootPid = hasRootPid || target.rootPid > 0;
+    }
+    if (!hasRootPid) {
+        return;
+    }
+
+    bool changed = true;
+    for (int pass = 0; changed && pass < 8; ++pass) {
+        changed = false;
+        for (ProcessEntry &process : m_processes) {
+            if (process.target >= 0) {
+                continue;
+            }
+            auto parent = std::lower_bound(m_processes.begin(), m_processes.end(), process.parentPid,
+                                           [](const ProcessEntry &entry, qint64 pid) { return entry.pid < pid; });
+            if (parent != m_processes.end() && parent->pid == process.parentPid && parent->target >= 0) {
+                process.target = parent->target;
+                changed = true;
+            }
+        }
+    }
+}
+
+ResourceMonitor::ResourceMonitor(QObject *parent)
+    : QObject(parent)
+    , m_thread(nullptr)
+    , m_sampler(nullptr)
+{
+    qRegisterMetaType<QVector<ResourceSample>>("QVector<ResourceSample>");
+
+    m_thread = new QThread(this);
+    m_sampler = new ResourceSampler(&m_mutex, &m_sharedTargets);
+    m_sampler->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_sampler, &QObject::deleteLater);
+    connect(m_sampler, &ResourceSampler::sampled, this, &ResourceMonitor::onSampled);
+    m_thread->start(QThread::LowPriority);
+}
+
+ResourceMonitor::~ResourceMonitor()
+{
+    m_thread->quit();
+    m_thread->wait();
+}
+
+void ResourceMonitor::track(const QString &appId, const QList<qint64> &processGroupIds, qint64 rootPid)
+{
+    ResourceTarget target;
+    target.appId = appId;
+    target.processGroupIds = processGroupIds;
+    target.rootPid = rootPid;
+    m_targets.insert(appId, target);
+    publishTargets();
+}
+
+void ResourceMonitor::untrack(const QString &appId)
+{
+    // 历史记录保留，仍可导出
+    if (m_targets.remove(appId) > 0) {
+        publishTargets();
+    }
+}
+
+void ResourceMonitor::publishTargets()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_sharedTargets = m_targets.values().toVector();
+    }
+    QMetaObject::invokeMethod(m_sampler, "setActive", Qt::QueuedConnection, Q_ARG(bool, !m_targets.isEmpty()));
+}
+
+void ResourceMonitor::onSampled(const QVector<ResourceSample> &samples, const QStringList &appIds)
+{
+    for (int i = 0; i < samples.size() && i < appIds.size(); ++i) {
+        // 采样期间可能已停止跟踪
+        if (!m_targets.contains(appIds[i])) {
+            continue;
+        }
+        auto history = m_history.find(appIds[i]);
+        if (history == m_history.end()) {
+            history = m_history.insert(appIds[i], ResourceHistory(HISTORY_SECONDS * 1000 / SAMPLE_INTERVAL));
+        }
+        history->append(samples[i]);
+    }
+    emit updated();
+}
+
+bool ResourceMonitor::latest(const QString &appId, ResourceSample *sample) const
+{
+    auto history = m_history.constFind(appId);
+    if (!m_targets.contains(appId) || history == m_history.constEnd() || history->size() == 0) {
+        return false;
+    }
+    *sample = history->last();
+    return true;
+}
+
+QString ResourceMonitor::describe(const ResourceSample &sample)
+{
+    return QString("CPU %1% · 内存 %2 · 读 %3/s · 写 %4/s · %5 个进程")
+            .arg(sample.cpuPercent, 0, 'f', 0)
+            .arg(formatBytes(sample.rssBytes))
+            .arg(formatBytes(sample.readBytesPerSec))
+            .arg(formatBytes(sample.writeBytesPerSec))
+            .arg(sample.processCount);
+}
+
+bool ResourceMonitor::exportCsv(const QString &path, QString *error) const
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        *error = file.errorString();
+        return false;
+    }
+
+    file.write("app,time,cpu_percent,rss_bytes,read_bytes_per_sec,write_bytes_per_sec,processes\n");
+    QStringList appIds = m_history.keys();
+    appIds.sort();
+    for (const QString &appId : appIds) {
+        const ResourceHistory &history = m_history.constFind(appId).value();
+        for (int i = 0; i < history.size(); ++i) {
+            const ResourceSample &sample = history.at(i);
+            file.write(QString("%1,%2,%3,%4,%5,%6,%7\n")
+                       .arg(appId)
+                       .arg(QDateTime::fromMSecsSinceEpoch(sample.timestamp).toString(Qt::ISODateWithMs))
+                       .arg(sample.cpuPercent, 0, 'f', 1)
+                       .arg(sample.rssBytes)
+                       .arg(sample.readBytesPerSec)
+                       .arg(sample.writeBytesPerSec)
+                       .arg(sample.processCount)
+                       .toUtf8());
+        }
+    }
+
+    if (!file.commit()) {
+        *error = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,162 @@
+#ifndef RESOURCEMONITOR_H
+#define RESOURCEMONITOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#endif
+
+class QThread;
+class QTimer;
+
+/**
+ * @brief 一个应用程序（整个进程树）在一次采样中的资源占用
+ */
+struct ResourceSample {
+    qint64 timestamp = 0;          // 毫秒（Unix时间）
+    double cpuPercent = 0.0;       // 100%表示占满一个核心
+    qint64 rssBytes = 0;
+    qint64 readBytesPerSec = 0;
+    qint64 writeBytesPerSec = 0;
+    int processCount = 0;
+};
+Q_DECLARE_METATYPE(ResourceSample)
+
+/**
+ * @brief 固定容量的采样环形缓冲区，写满后覆盖最旧的采样
+ */
+class ResourceHistory
+{
+public:
+    explicit ResourceHistory(int capacity = 0) : m_samples(capacity), m_head(0), m_size(0) {}
+
+    void append(const ResourceSample &sample);
+    int size() const { return m_size; }
+    // 按时间顺序访问，0为最旧的采样
+    const ResourceSample &at(int i) const { return m_samples.at((m_head + i) % m_samples.size()); }
+    const ResourceSample &last() const { return at(m_size - 1); }
+
+private:
+    QVector<ResourceSample> m_samples;
+    int m_head;
+    int m_size;
+};
+
+/**
+ * @brief 被采样的应用程序：进程组中的进程及rootPid的所有后代都计入该应用
+ */
+struct ResourceTarget {
+    QString appId;
+    QList<qint64> processGroupIds;
+    qint64 rootPid = 0;
+};
+
+/**
+ * @brief 后台线程中的/proc采样器（由ResourceMonitor创建，不直接使用）
+ *
+ * 每次采样遍历/proc，用栈上缓冲区读取stat、statm和io并原地解析，逐个文件的读取不分配内存；
+ * 进程表使用预留容量的std::vector，只在进程数超过历史最大值时扩容。
+ * 每次采样仍会为结果构建QVector、QStringList和m_previous中的QHash条目（与应用数量成正比）
+ */
+class ResourceSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    ResourceSampler(QMutex *mutex, const QVector<ResourceTarget> *targets);
+    ~ResourceSampler();
+
+public slots:
+    void setActive(bool active);
+
+signals:
+    void sampled(const QVector<ResourceSample> &samples, const QStringList &appIds);
+
+private slots:
+    void sample();
+
+private:
+    struct ProcessEntry {
+        qint64 pid;
+        qint64 parentPid;
+        qint64 processGroupId;
+        quint64 cpuTicks;
+        int target;                // 所属应用在targets中的下标，-1为无关进程
+    };
+
+    struct Totals {
+        quint64 cpuTicks = 0;
+        quint64 readBytes = 0;
+        quint64 writeBytes = 0;
+        qint64 timestamp = 0;
+    };
+
+    void scanProcesses(const QVector<ResourceTarget> &targets);
+    void assignDescendants(const QVector<ResourceTarget> &targets);
+
+    QMutex *m_mutex;
+    const QVector<ResourceTarget> *m_targets;
+    QTimer *m_timer;
+    std::vector<ProcessEntry> m_processes;
+    QHash<QString, Totals> m_previous;
+    long m_clockTicks;
+    long m_pageSize;
+#ifdef Q_OS_LINUX
+    DIR *m_procDirectory;          // 只打开一次，每次采样rewinddir
+#endif
+};
+
+/**
+ * @brief 应用程序资源占用监控
+ *
+ * 在后台线程中每秒从/proc采样受管进程树（包括终端启动的进程）的CPU、内存和IO，
+ * 结果回到界面线程后存入每个应用的环形缓冲区（保留最近HISTORY_SECONDS秒），可导出为CSV。
+ * 没有被跟踪的应用时采样线程保持空闲
+ */
+class ResourceMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int SAMPLE_INTERVAL = 1000;   // 毫秒
+    static constexpr int HISTORY_SECONDS = 600;    // 环形缓冲区保留的时长
+
+    explicit ResourceMonitor(QObject *parent = nullptr);
+    ~ResourceMonitor();
+
+    void track(const QString &appId, const QList<qint64> &processGroupIds, qint64 rootPid = 0);
+    void untrack(const QString &appId);
+
+    // 最近一次采样；尚无采样时返回false
+    bool latest(const QString &appId, ResourceSample *sample) const;
+    static QString describe(const ResourceSample &sample);
+
+    bool exportCsv(const QString &path, QString *error) const;
+
+signals:
+    void updated();
+
+private slots:
+    void onSampled(const QVector<ResourceSample> &samples, const QStringList &appIds);
+
+private:
+    void publishTargets();
+
+    QThread *m_thread;
+    ResourceSampler *m_sampler;
+    mutable QMutex m_mutex;              // 保护m_sharedTargets（采样线程只复制隐式共享的引用）
+    QVector<ResourceTarget> m_sharedTargets;
+    QHash<QString, ResourceTarget> m_targets;
+    QHash<QString, ResourceHistory> m_history;
+};
+
+#endif // RESOURCEMONITOR_H
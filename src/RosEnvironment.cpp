@@ -0,0 +1,248 @@
+#include "RosEnvironment.h"
+#include "qt_compatibility.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFile>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QDebug>
+
+namespace {
+    // setup.bash会依次source同目录及各overlay前缀下的这些文件
+    const QStringList kSetupFileNames = {
+        "setup.bash", "setup.sh", "local_setup.bash", "local_setup.sh", "_setup_util.py"
+    };
+}
+
+RosEnvironment::RosEnvironment(QObject *parent)
+    : QObject(parent)
+    , m_captureProcess(nullptr)
+    , m_ready(false)
+{
+}
+
+QString RosEnvironment::findSetupScript()
+{
+    // 与shell的/opt/ros/*/setup.bash展开顺序一致：按名称排序取第一个
+    QDir rosRoot("/opt/ros");
+    const QStringList distros = rosRoot.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString &distro : distros) {
+        QFileInfo setupFile(rosRoot.filePath(distro + "/setup.bash"));
+        if (setupFile.isFile()) {
+            return setupFile.absoluteFilePath();
+        }
+    }
+    return QString();
+}
+
+QString RosEnvironment::snapshotPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/ros_environment.json";
+}
+
+bool RosEnvironment::clearSnapshot()
+{
+    QFile snapshot(snapshotPath());
+    if (!snapshot.exists()) {
+        return true;
+    }
+    qDebug() << "删除ROS环境快照:" << snapshot.fileName();
+    return snapshot.remove();
+}
+
+QString RosEnvironment::findExecutable(const QString &name) const
+{
+    const QStringList paths = QtCompat::splitSkipEmpty(m_environment.value("PATH"), ':');
+    return QStandardPaths::findExecutable(name, paths);
+}
+
+void RosEnvironment::resolve()
+{
+    if (m_ready) {
+        emit ready(m_environment);
+        return;
+    }
+
+    if (m_captureProcess) {
+        qDebug() << "ROS环境正在解析中";
+        return;
+    }
+
+    // 启动器本身已在ROS环境中运行时直接使用当前环境
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains("ROS_DISTRO") && applyEnvironment(systemEnvironment)) {
+        qDebug() << "使用当前进程的ROS环境，ROS_DISTRO:" << systemEnvironment.value("ROS_DISTRO");
+        emit ready(m_environment);
+        return;
+    }
+
+    m_setupScript = findSetupScript();
+    if (m_setupScript.isEmpty()) {
+        emit failed("未找到 /opt/ros/*/setup.bash");
+        return;
+    }
+
+    if (loadSnapshot()) {
+        emit ready(m_environment);
+        return;
+    }
+
+    qDebug() << "解析ROS环境:" << m_setupScript;
+
+    // setup脚本路径作为位置参数传入，避免引号转义问题
+    m_captureProcess = new QProcess(this);
+    m_captureProcess->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_captureProcess, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &RosEnvironment::onCaptureFinished);
+    connect(m_captureProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            m_captureProcess->deleteLater();
+            m_captureProcess = nullptr;
+            emit failed("无法启动bash");
+        }
+    });
+    m_captureProcess->start("bash", QStringList() << "-c"
+                            << "source \"$1\" >/dev/null 2>&1 && env -0"
+                            << "bash" << m_setupScript);
+}
+
+void RosEnvironment::onCaptureFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    QByteArray output = m_captureProcess->readAllStandardOutput();
+    m_captureProcess->deleteLater();
+    m_captureProcess = nullptr;
+
+    if (exitStatus != QProcess::NormalExit || exitCode != 0) {
+        emit failed(QString("source %1 失败，退出代码: %2").arg(m_setupScript).arg(exitCode));
+        return;
+    }
+
+    // env -0 输出以NUL分隔的 KEY=VALUE 列表，值中可能包含换行
+    QProcessEnvironment environment;
+    const QList<QByteArray> entries = output.split('\0');
+    for (const QByteArray &entry : entries) {
+        int separator = entry.indexOf('=');
+        if (separator > 0) {
+            environment.insert(QString::fromLocal8Bit(entry.left(separator)),
+                               QString::fromLocal8Bit(entry.mid(separator + 1)));
+        }
+    }
+
+    if (!environment.contains("ROS_DISTRO") || !applyEnvironment(environment)) {
+        emit failed(QString("%1 未导出可用的ROS环境").arg(m_setupScript));
+        return;
+    }
+
+    qDebug() << "ROS环境解析完成，ROS_DISTRO:" << m_environment.value("ROS_DISTRO")
+             << "变量数:" << m_environment.keys().size();
+    saveSnapshot();
+    emit ready(m_environment);
+}
+
+QStringList RosEnvironment::sourcedFiles(const QProcessEnvironment &environment) const
+{
+    // 入口脚本所在目录和CMAKE_PREFIX_PATH中的每个overlay前缀
+    QStringList prefixes;
+    prefixes << QFileInfo(m_setupScript).absolutePath();
+    prefixes << QtCompat::splitSkipEmpty(environment.value("CMAKE_PREFIX_PATH"), ':');
+
+    QStringList files;
+    for (const QString &prefix : prefixes) {
+        for (const QString &name : kSetupFileNames) {
+            QFileInfo fileInfo(QDir(prefix).filePath(name));
+            if (fileInfo.isFile() && !files.contains(fileInfo.absoluteFilePath())) {
+                files << fileInfo.absoluteFilePath();
+            }
+        }
+    }
+    return files;
+}
+
+bool RosEnvironment::loadSnapshot()
+{
+    QFile file(snapshotPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject snapshot = QJsonDocument::fromJson(file.readAll()).object();
+    if (snapshot.value("setupScript").toString() != m_setupScript) {
+        qDebug() << "ROS环境快照对应的setup脚本已变化，重新解析";
+        return false;
+    }
+
+    // 任一被source的文件修改时间变化（或被删除）都使快照失效
+    const QJsonObject files = snapshot.value("files").toObject();
+    if (files.isEmpty()) {
+        return false;
+    }
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        QFileInfo fileInfo(it.key());
+        if (!fileInfo.exists()
+                || fileInfo.lastModified().toMSecsSinceEpoch() != static_cast<qint64>(it.value().toDouble())) {
+            qDebug() << "ROS环境快照已过期:" << it.key();
+            return false;
+        }
+    }
+
+    QProcessEnvironment environment;
+    const QJsonObject variables = snapshot.value("environment").toObject();
+    for (auto it = variables.constBegin(); it != variables.constEnd(); ++it) {
+        environment.insert(it.key(), it.value().toString());
+    }
+
+    if (!applyEnvironment(environment)) {
+        return false;
+    }
+
+    qDebug() << "使用ROS环境快照，ROS_DISTRO:" << m_environment.value("ROS_DISTRO");
+    return true;
+}
+
+void RosEnvironment::saveSnapshot() const
+{
+    QJsonObject files;
+    const QStringList sourced = sourcedFiles(m_environment);
+    for (const QString &path : sourced) {
+        files.insert(path, static_cast<double>(QFileInfo(path).lastModified().toMSecsSinceEpoch()));
+    }
+
+    QJsonObject variables;
+    const QStringList keys = m_environment.keys();
+    for (const QString &key : keys) {
+        variables.insert(key, m_environment.value(key));
+    }
+
+    QJsonObject snapshot;
+    snapshot.insert("setupScript", m_setupScript);
+    snapshot.insert("files", files);
+    snapshot.insert("environment", variables);
+
+    // 先写临时文件再原子替换，避免中断时留下损坏的快照
+    QSaveFile file(snapshotPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "无法写入ROS环境快照:" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(snapshot).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "保存ROS环境快照失败:" << file.fileName();
+        return;
+    }
+    qDebug() << "ROS环境快照已保存，跟踪文件数:" << sourced.size();
+}
+
+bool RosEnvironment::applyEnvironment(const QProcessEnvironment &environment)
+{
+    QStringList paths = QtCompat::splitSkipEmpty(environment.value("PATH"), ':');
+    if (QStandardPaths::findExecutable("roscore", paths).isEmpty()) {
+        return false;
+    }
+
+    m_environment = environment;
+    m_ready = true;
+    return true;
+}
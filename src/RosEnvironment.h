@@ -0,0 +1,58 @@
+#ifndef ROSENVIRONMENT_H
+#define ROSENVIRONMENT_H
+
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+
+/**
+ * @brief ROS运行环境解析
+ *
+ * 在后台bash中source一次/opt/ros/<distro>/setup.bash，捕获其导出的全部环境变量，
+ * 之后roscore/rviz等进程直接以该环境启动，无需再经过终端和shell脚本。
+ * 捕获结果以快照形式保存在AppDataLocation中，以各setup文件的修改时间为键，
+ * 任一文件变化时快照自动失效
+ */
+class RosEnvironment : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RosEnvironment(QObject *parent = nullptr);
+
+    // 异步解析环境；已缓存时立即发出ready信号
+    void resolve();
+
+    bool isReady() const { return m_ready; }
+    QProcessEnvironment environment() const { return m_environment; }
+
+    // 在ROS环境的PATH中查找可执行文件
+    QString findExecutable(const QString &name) const;
+
+    // 查找ROS安装的setup.bash（与原先的/opt/ros/*/setup.bash取同一个）
+    static QString findSetupScript();
+
+    // 快照文件路径，以及强制下次重新解析（--refresh-ros-env）
+    static QString snapshotPath();
+    static bool clearSnapshot();
+
+signals:
+    void ready(const QProcessEnvironment &environment);
+    void failed(const QString &reason);
+
+private slots:
+    void onCaptureFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
+private:
+    bool applyEnvironment(const QProcessEnvironment &environment);
+    bool loadSnapshot();
+    void saveSnapshot() const;
+    QStringList sourcedFiles(const QProcessEnvironment &environment) const;
+
+    QProcess *m_captureProcess;
+    QProcessEnvironment m_environment;
+    QString m_setupScript;
+    bool m_ready;
+};
+
+#endif // ROSENVIRONMENT_H
@@ -0,0 +1,151 @@
+#include "StartupTrace.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+#include <QDebug>
+
+namespace {
+    struct TraceEvent {
+        const char *name;
+        char phase;        // 'B'开始 / 'E'结束 / 'i'瞬时事件（Chrome trace约定）
+        qint64 timestampNs;
+    };
+
+    struct TraceState {
+        QElapsedTimer clock;
+        QVector<TraceEvent> events;
+        QString outputPath;
+        bool enabled = false;
+        bool quitAfterFirstFrame = false;
+        bool written = false;
+    };
+
+    TraceState &traceState()
+    {
+        static TraceState state;
+        return state;
+    }
+
+    void record(const char *name, char phase)
+    {
+        TraceState &state = traceState();
+        if (!state.clock.isValid()) {
+            state.clock.start();
+        }
+        state.events.append({name, phase, state.clock.nsecsElapsed()});
+    }
+}
+
+StartupTrace::StartupTrace(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void StartupTrace::start()
+{
+    TraceState &state = traceState();
+    state.events.reserve(64);
+    state.clock.start();
+    record("main", 'B');
+}
+
+void StartupTrace::begin(const char *name)
+{
+    record(name, 'B');
+}
+
+void StartupTrace::end(const char *name)
+{
+    record(name, 'E');
+}
+
+void StartupTrace::mark(const char *name)
+{
+    record(name, 'i');
+}
+
+void StartupTrace::enable(const QString &outputPath, bool quitAfterFirstFrame)
+{
+    TraceState &state = traceState();
+    state.enabled = true;
+    state.outputPath = outputPath;
+    state.quitAfterFirstFrame = quitAfterFirstFrame;
+}
+
+bool StartupTrace::isEnabled()
+{
+    return traceState().enabled;
+}
+
+void StartupTrace::watchFirstFrame(QWidget *widget)
+{
+    // 过滤器对象随窗口销毁
+    widget->installEventFilter(new StartupTrace(widget));
+}
+
+bool StartupTrace::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() != QEvent::Paint) {
+        return false;
+    }
+
+    watched->removeEventFilter(this);
+    deleteLater();
+
+    // 本次绘制结束后（回到事件循环时）才算首帧完成
+    mark("first-paint");
+    QTimer::singleShot(0, []() {
+        mark("first-frame");
+        end("main");
+
+        TraceState &state = traceState();
+        if (!state.enabled) {
+            return;
+        }
+        write();
+        if (state.quitAfterFirstFrame) {
+            QCoreApplication::quit();
+        }
+    });
+    return false;
+}
+
+bool StartupTrace::write()
+{
+    TraceState &state = traceState();
+    if (!state.enabled || state.written) {
+        return false;
+    }
+
+    QFile file(state.outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "无法写入启动跟踪文件:" << state.outputPath;
+        return false;
+    }
+
+    // 每个事件单独一行，便于脚本逐行解析
+    const qint64 pid = QCoreApplication::applicationPid();
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (int i = 0; i < state.events.size(); ++i) {
+        const TraceEvent &event = state.events.at(i);
+        QByteArray line = QByteArray("{\"name\":\"") + event.name
+                + "\",\"cat\":\"startup\",\"ph\":\"" + event.phase
+                + "\",\"ts\":" + QByteArray::number(event.timestampNs / 1000.0, 'f', 3)
+                + ",\"pid\":" + QByteArray::number(pid) + ",\"tid\":1"
+                + (event.phase == 'i' ? ",\"s\":\"p\"}" : "}");
+        if (i + 1 < state.events.size()) {
+            line += ",";
+        }
+        file.write(line + "\n");
+    }
+    file.write("]}\n");
+    file.close();
+
+    state.written = true;
+    qDebug() << "启动跟踪已写入:" << state.outputPath << "事件数:" << state.events.size();
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QObject>
+#include <QString>
+
+class QWidget;
+
+/**
+ * @brief 启动阶段耗时跟踪（--trace-startup）
+ *
+ * 以单调时钟记录main()到首帧绘制之间各阶段的起止时间，
+ * 启用后在首帧绘制完成时输出Chrome trace格式的JSON（chrome://tracing / Perfetto可直接打开）。
+ * 未启用时只在内存中记录少量事件，开销可以忽略
+ */
+class StartupTrace : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 阶段计时（RAII）
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name) : m_name(name) { StartupTrace::begin(m_name); }
+        ~Scope() { StartupTrace::end(m_name); }
+
+    private:
+        const char *m_name;
+    };
+
+    // 必须在main()最开始调用一次，作为时间零点
+    static void start();
+
+    static void begin(const char *name);
+    static void end(const char *name);
+    static void mark(const char *name);
+
+    // 启用输出；quitAfterFirstFrame用于基准测试（写出结果后退出事件循环）
+    static void enable(const QString &outputPath, bool quitAfterFirstFrame);
+    static bool isEnabled();
+
+    // 监听窗口的首次绘制，记录first-frame并输出结果
+    static void watchFirstFrame(QWidget *widget);
+
+    static bool write();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit StartupTrace(QObject *parent = nullptr);
+};
+
+#endif // STARTUPTRACE_H
@@ -0,0 +1,1286 @@
+#include "Supervisor.h"
+#include "AppStopper.h"
+#include "RosEnvironment.h"
+#include "ReadinessProbe.h"
+#include "LaunchTimeline.h"
+#include "ProcessExitWatcher.h"
+#include "AppImagePrewarmer.h"
+#include "ExecutableLocator.h"
+#include "ResourceMonitor.h"
+#include "CgroupManager.h"
+#include "DaemonConnection.h"
+#include <QUrl>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+Supervisor::Supervisor(const AppRegistry &registry, QObject *parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_activeStoppers(0)
+    , m_shuttingDown(false)
+    , m_windowManagementAvailable(false)
+    , m_rosEnvironment(nullptr)
+    , m_launchTimeline(nullptr)
+    , m_exitWatcher(nullptr)
+    , m_resourceMonitor(nullptr)
+    , m_cgroupManager(nullptr)
+    , m_daemon(nullptr)
+{
+    // 注册应用程序（顺序即按钮顺序）
+    const QVector<AppDefinition> &definitions = registry.applications();
+    m_applications.reserve(definitions.size());
+    for (const AppDefinition &definition : definitions) {
+        AppProcess app;
+        app.definition = definition;
+        m_applicationIndex.insert(definition.id, m_applications.size());
+        m_applications.append(app);
+    }
+    
+    // 启动耗时记录
+    m_launchTimeline = new LaunchTimeline(this);
+    
+    // 受管进程由QProcess信号驱动，终端启动的进程由pidfd通知
+    m_exitWatcher = new ProcessExitWatcher(this);
+    connect(m_exitWatcher, &ProcessExitWatcher::exited, this, &Supervisor::onDetachedProcessExited);
+    
+    m_supervisionClock.start();
+    
+    // 资源采样只在有受管进程时运行
+    m_resourceMonitor = new ResourceMonitor(this);
+    
+    // cgroup子树在第一次需要cpuMax/memoryMax时才初始化
+    m_cgroupManager = new CgroupManager(this);
+    
+    // ROS受管启动（环境只解析一次并缓存）
+    m_rosEnvironment = new RosEnvironment(this);
+    connect(m_rosEnvironment, &RosEnvironment::ready, this, &Supervisor::onRosEnvironmentReady);
+    connect(m_rosEnvironment, &RosEnvironment::failed, this, &Supervisor::onRosEnvironmentFailed);
+    
+    qDebug() << "应用程序监管核心初始化完成，已注册应用程序:" << m_applicationIndex.keys();
+}
+
+Supervisor::~Supervisor()
+{
+    // 停止所有应用程序（不阻塞等待）
+    killAllApplicationsNow();
+}
+
+void Supervisor::enablePrewarm()
+{
+    if (m_daemon) {
+        // 由守护进程启动应用程序，预热也由它负责
+        return;
+    }
+    
+    for (int i = 0; i < m_applications.size(); ++i) {
+        AppProcess &app = m_applications[i];
+        if (!app.definition.prewarm || app.prewarmer) {
+            continue;
+        }
+        
+        app.prewarmer = new AppImagePrewarmer(this);
+        const QString appId = app.definition.id;
+        connect(app.prewarmer, &AppImagePrewarmer::failed, this, [appId](const QString &reason) {
+            qWarning() << appId << "预热失败，将按原方式启动:" << reason;
+        });
+        
+        QTimer::singleShot(PREWARM_DELAY, this, [this, i]() {
+            AppProcess &app = m_applications[i];
+            if (app.prewarmer->isReady()) {
+                return;
+            }
+            QString appImagePath = resolveProgram(i);
+            if (appImagePath.isEmpty()) {
+                qDebug() << "未找到" << app.definition.id << "的AppImage，跳过预热";
+                return;
+            }
+            app.prewarmer->start(appImagePath);
+        });
+    }
+}
+
+QString Supervisor::resolveProgram(int index)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition &definition = app.definition;
+    
+    // 预热完成时直接启动解包后的程序，跳过路径搜索和FUSE挂载
+    if (app.prewarmer) {
+        QString prewarmed = app.prewarmer->executable();
+        if (!prewarmed.isEmpty()) {
+            qDebug() << "使用预热的" << definition.id << ":" << prewarmed;
+            return prewarmed;
+        }
+    }
+    
+    // 声明了搜索路径的程序：首次调用时才构建候选列表，之后由缓存和目录监视保证结果有效
+    if (!definition.searchPaths.isEmpty()) {
+        if (!app.locator) {
+            QByteArray variable = "FLIGHTCONTROLS_" + definition.id.toUpper().toLatin1() + "_PATH";
+            QStringList candidates = ExecutableLocator::candidatesFromEnvironment(variable.constData());
+            candidates << definition.searchPaths;
+            app.locator = new ExecutableLocator(definition.id, candidates, this);
+        }
+        return app.locator->resolve();
+    }
+    
+    if (QFileInfo(definition.program).isAbsolute()) {
+        return QFileInfo(definition.program).isExecutable() ? definition.program : QString();
+    }
+    if (definition.usesRosEnvironment()) {
+        return m_rosEnvironment->findExecutable(definition.program);
+    }
+    return QStandardPaths::findExecutable(definition.program);
+}
+
+QProcessEnvironment Supervisor::applicationEnvironment(int index) const
+{
+    const AppDefinition &definition = m_applications[index].definition;
+    QProcessEnvironment environment = definition.usesRosEnvironment()
+            ? m_rosEnvironment->environment()
+            : QProcessEnvironment::systemEnvironment();
+    for (auto it = definition.extraEnvironment.constBegin(); it != definition.extraEnvironment.constEnd(); ++it) {
+        environment.insert(it.key(), it.value());
+    }
+    return environment;
+}
+
+ManagedProcess::SchedulingPolicy Supervisor::schedulingPolicy(int index)
+{
+    const AppDefinition &definition = m_applications[index].definition;
+    const AppDefinition::ResourcePolicy &resources = definition.resources;
+    
+    ManagedProcess::SchedulingPolicy policy;
+    policy.setNice = resources.hasNice;
+    policy.nice = resources.nice;
+    policy.cpus = resources.cpus;
+#ifdef Q_OS_LINUX
+    static const QHash<QString, int> schedulers = {
+        {"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE},
+        {"fifo", SCHED_FIFO}, {"rr", SCHED_RR}
+    };
+    policy.scheduler = schedulers.value(resources.scheduler, -1);
+    policy.priority = (resources.scheduler == "fifo" || resources.scheduler == "rr") ? resources.priority : 0;
+#endif
+    if (resources.usesCgroup()) {
+        // 无法使用cgroup时其余策略照常应用
+        policy.cgroupProcsPath = m_cgroupManager->applicationGroup(definition.id, resources.cpuMax, resources.memoryMax);
+    }
+    return policy;
+}
+
+void Supervisor::startApplication(int index)
+{
+    AppProcess &app = m_applications[index];
+    const QString &appId = app.definition.id;
+    
+    if (m_daemon) {
+        m_daemon->send("start " + appId);
+        return;
+    }
+    
+    if (app.isStopping) {
+        qDebug() << appId << "正在停止中，稍后再启动";
+        return;
+    }
+    
+    if (app.isRunning) {
+        qDebug() << appId << "已在运行中";
+        return;
+    }
+    
+    // 清理之前的进程实例：仍在运行时异步结束，完成后再继续启动，不阻塞事件循环
+    if (app.process) {
+        if (app.process->state() != QProcess::NotRunning) {
+            qDebug() << "终止之前的" << appId << "进程";
+            AppStopper::Plan plan;
+            plan.processGroupIds = QList<qint64>() << app.process->processGroupId();
+            plan.terminateTimeout = 0;              // 直接升级为SIGKILL
+            plan.killTimeout = PROCESS_KILL_TIMEOUT;
+            AppStopper *stopper = new AppStopper(appId, app.process, plan, this);
+            connect(stopper, &AppStopper::finished, this, [this, index]() {
+                m_activeStoppers--;
+                AppProcess &previous = m_applications[index];
+                previous.isStopping = false;
+                if (previous.process) {
+                    previous.process->deleteLater();
+                    previous.process = nullptr;
+                }
+                previous.processGroupIds.clear();
+                emit stateChanged();
+                if (!m_shuttingDown) {
+                    startApplication(index);
+                } else if (m_activeStoppers == 0) {
+                    emit allApplicationsStopped();
+                }
+            });
+            app.isStopping = true;
+            m_activeStoppers++;
+            emit stateChanged();
+            stopper->start();
+            return;
+        }
+        app.process->deleteLater();
+        app.process = nullptr;
+    }
+    app.processGroupIds.clear();
+    app.ownedDependencies.clear();
+    app.isDetached = false;
+    app.isReady = false;
+    app.isExternal = false;
+    app.existingChecked = false;
+    
+    qDebug() << "启动" << appId << ":" << app.definition.program << app.definition.arguments;
+    
+    app.isRunning = true;
+    emit stateChanged();
+    continueLaunch(index);
+}
+
+void Supervisor::continueLaunch(int index)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition &definition = app.definition;
+    if (!app.isRunning || app.isStopping || app.isReady || app.isDetached || app.process) {
+        return; // 启动已被取消或进程已启动
+    }
+    
+    // 1. ROS环境：已缓存时立即回调，否则在后台source一次setup.bash
+    if (definition.usesRosEnvironment() && !m_rosEnvironment->isReady()) {
+        qDebug() << "准备ROS环境...";
+        m_rosEnvironment->resolve();
+        return;
+    }
+    if (definition.usesRosEnvironment()) {
+        m_launchTimeline->mark(definition.id, "ros-env-ready");
+    }
+    
+    // 2. 依赖：未运行的由本应用启动（并随本应用停止），全部就绪后才继续
+    bool dependenciesReady = true;
+    for (int dependency : definition.dependencies) {
+        AppProcess &dependencyApp = m_applications[dependency];
+        if (dependencyApp.isStopping) {
+            dependenciesReady = false;
+            continue;
+        }
+        if (!dependencyApp.isRunning) {
+            qDebug() << definition.id << "依赖的" << dependencyApp.definition.id << "未运行，先启动依赖";
+            app.ownedDependencies << dependency;
+            startApplication(dependency);
+            if (!app.isRunning || app.isStopping || app.process) {
+                return; // 依赖同步就绪时已递归推进本应用的启动，或启动已失败
+            }
+        }
+        if (!m_applications[dependency].isReady) {
+            dependenciesReady = false;
+        }
+    }
+    if (!dependenciesReady) {
+        return; // 依赖就绪（markReady）时会再次推进
+    }
+    if (!definition.dependencies.isEmpty()) {
+        m_launchTimeline->mark(definition.id, "dependencies-ready");
+    }
+    
+    // 3. 允许复用已有实例时，先检查就绪条件是否已满足（例如其他终端启动的roscore）
+    if (definition.reuseExisting && definition.readiness.canDetectExisting() && !app.existingChecked) {
+        app.existingChecked = true;
+        startReadinessProbe(index, true);
+        return;
+    }
+    
+    // 4. 启动进程，之后等待就绪
+    if (!spawnApplication(index)) {
+        return;
+    }
+    if (definition.readiness.type == "none") {
+        markReady(index);
+        return;
+    }
+    if (definition.readiness.type == "window") {
+        if (!m_windowManagementAvailable) {
+            // 无界面运行时无法观察窗口，进程启动即视为就绪
+            markReady(index);
+            return;
+        }
+        // 窗口搜索本身就是就绪探测，进程启动后立即开始
+        emit windowSearchRequested(index);
+    }
+    startReadinessProbe(index, false);
+}
+
+bool Supervisor::spawnApplication(int index)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition &definition = app.definition;
+    
+    QString executable = resolveProgram(index);
+    m_launchTimeline->mark(definition.id, "path-resolved");
+    if (executable.isEmpty()) {
+        qWarning() << "未找到" << definition.id << "的程序:" << definition.program;
+        failLaunch(index, definition.missingMessage.isEmpty()
+                   ? QString("未找到%1，请确认已正确安装").arg(definition.program)
+                   : definition.missingMessage);
+        return false;
+    }
+    
+    // 受管进程（独立进程组），停止时可以一并结束其所有子进程
+    ManagedProcess *process = new ManagedProcess(this);
+    // Qt 5.9兼容的信号连接方式
+    connect(process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &Supervisor::onProcessFinished);
+    connect(process, &QProcess::stateChanged, this, &Supervisor::stateChanged);
+    process->setProcessEnvironment(applicationEnvironment(index));
+    if (definition.readiness.type == "log") {
+        // 等待日志行时读取输出送给就绪探测，之后继续读取并丢弃，避免管道写满阻塞应用
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        connect(process, &QProcess::readyReadStandardOutput, this, [this, index, process]() {
+            QByteArray output = process->readAllStandardOutput();
+            ReadinessProbe *probe = m_applications[index].probe;
+            if (probe && m_applications[index].process == process) {
+                probe->feed(output);
+            }
+        });
+    } else {
+        process->setStandardOutputFile(QProcess::nullDevice());
+        process->setStandardErrorFile(QProcess::nullDevice());
+    }
+    connect(process, &QProcess::errorOccurred, this, [this, index, process](QProcess::ProcessError error) {
+        // 同步启动失败在下面处理，这里只处理fork之后exec失败的情况
+        if (error == QProcess::FailedToStart && m_applications[index].process == process) {
+            failLaunch(index, QString("启动 %1 失败: %2").arg(m_applications[index].definition.label, process->errorString()));
+        }
+    });
+    if (!definition.resources.isEmpty()) {
+        process->setSchedulingPolicy(schedulingPolicy(index));
+    }
+    process->start(executable, definition.arguments);
+    
+    // fork之后即可得到PID（也就是进程组ID），无需等待started信号
+    if (process->processId() <= 0) {
+        QString errorMsg = QString("启动 %1 失败: %2").arg(definition.label, process->errorString());
+        qWarning() << errorMsg;
+        process->deleteLater();
+        failLaunch(index, errorMsg);
+        return false;
+    }
+    
+    app.process = process;
+    app.processGroupIds.clear();
+    if (process->processGroupId() > 0) {
+        app.processGroupIds << process->processGroupId();
+    }
+    app.uptime.start();
+    m_resourceMonitor->track(definition.id, app.processGroupIds, process->processId());
+    m_launchTimeline->mark(definition.id, "process-started");
+    qDebug() << definition.id << "启动成功，PID:" << process->processId() << "进程组:" << process->processGroupId();
+    
+    emit stateChanged();
+    return true;
+}
+
+void Supervisor::startReadinessProbe(int index, bool checkOnly)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition::Readiness &readiness = app.definition.readiness;
+    
+    if (!app.probe) {
+        app.probe = new ReadinessProbe(this);
+        connect(app.probe, &ReadinessProbe::ready, this, [this, index]() { onReadinessProbeReady(index); });
+        connect(app.probe, &ReadinessProbe::timedOut, this, [this, index]() { onReadinessProbeTimeout(index); });
+    }
+    app.probeCheckOnly = checkOnly;
+    int timeout = checkOnly ? 0 : readiness.timeout;
+    
+    if (readiness.type == "file") {
+        app.probe->waitForFile(readiness.path, timeout);
+        return;
+    }
+    if (readiness.type == "log") {
+        app.probe->waitForLogLine(QRegularExpression(readiness.pattern), timeout);
+        return;
+    }
+    if (readiness.type == "window") {
+        app.probe->waitForEvent(timeout);
+        return;
+    }
+    
+    // 端口：地址优先取自环境变量（如ROS_MASTER_URI），无效时使用声明的默认值
+    QString host = readiness.host;
+    quint16 port = static_cast<quint16>(readiness.port);
+    if (!readiness.urlVariable.isEmpty()) {
+        QString value = applicationEnvironment(index).value(readiness.urlVariable);
+        QUrl url(value);
+        if (!value.isEmpty() && url.isValid() && !url.host().isEmpty()) {
+            host = url.host();
+            port = static_cast<quint16>(url.port(readiness.port));
+        } else if (!value.isEmpty()) {
+            qWarning() << readiness.urlVariable << "无效，使用默认地址";
+        }
+    }
+    
+    if (readiness.type == "udp") {
+        app.probe->waitForUdpPort(port, timeout);
+    } else {
+        app.probe->waitForTcpPort(host, port, timeout);
+    }
+}
+
+void Supervisor::onReadinessProbeReady(int index)
+{
+    AppProcess &app = m_applications[index];
+    if (!app.isRunning || app.isStopping) {
+        return;
+    }
+    
+    if (app.probeCheckOnly) {
+        qDebug() << "检测到已运行的" << app.definition.id << "，直接使用";
+        app.isExternal = true;
+    }
+    markReady(index);
+}
+
+void Supervisor::onReadinessProbeTimeout(int index)
+{
+    AppProcess &app = m_applications[index];
+    if (!app.isRunning || app.isStopping) {
+        return;
+    }
+    
+    if (app.probeCheckOnly) {
+        // 没有现成的实例，由启动器启动并管理
+        continueLaunch(index);
+        return;
+    }
+    
+    qWarning() << "等待" << app.definition.id << "就绪超时";
+    if (!app.definition.readiness.failOnTimeout) {
+        // 就绪条件只用于提前推进，超时后按进程已启动继续
+        markReady(index);
+        return;
+    }
+    failLaunch(index, QString("%1在%2秒内未就绪，请检查环境配置")
+               .arg(app.definition.label).arg(app.definition.readiness.timeout / 1000));
+}
+
+void Supervisor::markReady(int index)
+{
+    AppProcess &app = m_applications[index];
+    app.isReady = true;
+    m_launchTimeline->mark(app.definition.id, "ready");
+    emit stateChanged();
+    
+    // 推进等待该应用的其他启动
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (isLaunching(i) && m_applications[i].definition.dependencies.contains(index)) {
+            continueLaunch(i);
+        }
+    }
+    
+    if (app.definition.readiness.type == "window") {
+        // 窗口搜索在进程启动时已开始，由窗口处理流程完成最大化和耗时记录
+    } else if (app.definition.hasWindow() && m_windowManagementAvailable) {
+        // 由界面搜索窗口（事件驱动或定时轮询）
+        emit windowSearchRequested(index);
+    } else {
+        m_launchTimeline->finish(app.definition.id, "ready");
+    }
+}
+
+void Supervisor::failLaunch(int index, const QString &message)
+{
+    AppProcess &app = m_applications[index];
+    if (!app.isRunning || app.isStopping) {
+        return;
+    }
+    
+    m_launchTimeline->finish(app.definition.id, "failed");
+    if (!message.isEmpty()) {
+        qWarning() << "启动失败:" << message;
+        emit launchFailed(index, message);
+    }
+    
+    // 已启动的进程和为本应用启动的依赖需要经过停止流程清理
+    if (app.process || !app.ownedDependencies.isEmpty()) {
+        stopApplication(index);
+    } else {
+        if (app.probe) {
+            app.probe->cancel();
+        }
+        app.isRunning = false;
+        emit stateChanged();
+    }
+    
+    // 等待该应用的其他启动也无法继续
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (isLaunching(i) && !m_applications[i].process && m_applications[i].definition.dependencies.contains(index)) {
+            failLaunch(i, QString());
+        }
+    }
+}
+
+void Supervisor::onRosEnvironmentReady()
+{
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (isLaunching(i) && m_applications[i].definition.usesRosEnvironment()) {
+            continueLaunch(i);
+        }
+    }
+}
+
+void Supervisor::onRosEnvironmentFailed(const QString &reason)
+{
+    for (int i = 0; i < m_applications.size(); ++i) {
+        AppProcess &app = m_applications[i];
+        if (!isLaunching(i) || app.process || app.isDetached || !app.definition.usesRosEnvironment()) {
+            continue;
+        }
+        
+        qWarning() << "无法直接解析ROS环境:" << reason;
+        if (!app.definition.terminalCommand.isEmpty()) {
+            qWarning() << app.definition.id << "回退到终端启动";
+            startInTerminal(i);
+        } else {
+            // 由其他应用回退到终端时一并启动（例如roscore），无需单独提示
+            failLaunch(i, QString());
+        }
+    }
+}
+
+bool Supervisor::resolveTerminal(int index)
+{
+    AppProcess &app = m_applications[index];
+    if (!app.terminalProgram.isEmpty()) {
+        return true; // 已缓存
+    }
+    
+    // 尝试多种终端，确保兼容性 - 直接在PATH中查找，无需fork which
+    QStringList terminals = {"gnome-terminal", "konsole", "xfce4-terminal", "xterm"};
+    QString availableTerminal;
+    
+    for (const QString &terminal : terminals) {
+        if (!QStandardPaths::findExecutable(terminal).isEmpty()) {
+            availableTerminal = terminal;
+            break;
+        }
+    }
+    
+    if (availableTerminal.isEmpty()) {
+        qWarning() << "未找到可用的终端程序，" << app.definition.id << "功能可能不可用";
+        return false;
+    }
+    
+    qDebug() << "使用终端程序:" << availableTerminal;
+    app.terminalProgram = availableTerminal;
+    
+    // 根据不同终端设置不同的参数 - 最小化终端大小，命令执行后立即退出
+    const QString &command = app.definition.terminalCommand;
+    if (availableTerminal == "gnome-terminal") {
+        app.terminalArguments = QStringList() << "--geometry=1x1+0+0" << "--" << "bash" << "-c" << command;
+    } else if (availableTerminal == "konsole") {
+        app.terminalArguments = QStringList() << "--geometry" << "1x1+0+0" << "-e" << "bash" << "-c" << command;
+    } else if (availableTerminal == "xfce4-terminal") {
+        app.terminalArguments = QStringList() << "--geometry=1x1+0+0" << "-e" << "bash" << "-c" << command;
+    } else { // xterm or others
+        app.terminalArguments = QStringList() << "-geometry" << "1x1+0+0" << "-e" << "bash" << "-c" << command;
+    }
+    return true;
+}
+
+void Supervisor::startInTerminal(int index)
+{
+    AppProcess &app = m_applications[index];
+    const QString &appId = app.definition.id;
+    
+    // 使用startDetached直接启动终端，终端中的进程无法由启动器跟踪
+    bool success = resolveTerminal(index) && QProcess::startDetached(app.terminalProgram, app.terminalArguments);
+    if (success) {
+        app.isDetached = true;
+        app.isReady = true;
+        m_launchTimeline->mark(appId, "terminal-started");
+        qDebug() << appId << "终端启动成功";
+        emit stateChanged();
+        
+        // 由界面搜索窗口（事件驱动或定时轮询）
+        if (app.definition.hasWindow() && m_windowManagementAvailable) {
+            emit windowSearchRequested(index);
+        }
+    } else {
+        QString errorMsg = QString("启动 %1 失败").arg(app.definition.label);
+        qWarning() << errorMsg;
+        failLaunch(index, errorMsg + "\n\n提示：\n" +
+            "- 请确保系统安装了终端程序（gnome-terminal、konsole、xfce4-terminal或xterm）\n" +
+            "- 请确保ROS环境已正确配置\n\n" +
+            "当前使用的终端：" + (app.terminalProgram.isEmpty() ? QString("无") : app.terminalProgram));
+    }
+}
+
+void Supervisor::onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    QProcess *process = qobject_cast<QProcess*>(sender());
+    if (!process) {
+        qWarning() << "进程结束信号发送者无效";
+        return;
+    }
+    
+    // 查找对应的应用程序
+    int index = -1;
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (m_applications[i].process == process) {
+            index = i;
+            break;
+        }
+    }
+    
+    if (index < 0) {
+        qWarning() << "无法找到对应的应用程序进程";
+        emit stateChanged();
+        return;
+    }
+    
+    AppProcess &app = m_applications[index];
+    QString statusText = (exitStatus == QProcess::NormalExit) ? "正常退出" : "异常终止";
+    qDebug() << app.definition.id << "进程结束 -" << statusText << "，退出代码:" << exitCode;
+    app.hasExited = true;
+    app.lastExitCode = exitCode;
+    app.lastExitCrashed = (exitStatus == QProcess::CrashExit);
+    
+    // 停止流程完成时会统一更新状态
+    if (app.isStopping || !app.isRunning) {
+        emit stateChanged();
+        return;
+    }
+    
+    // 依赖该应用的其他应用：尚未启动的中止，已运行的只提示
+    for (int i = 0; i < m_applications.size(); ++i) {
+        const AppProcess &dependent = m_applications[i];
+        if (!dependent.isRunning || dependent.isStopping || !dependent.definition.dependencies.contains(index)) {
+            continue;
+        }
+        if (dependent.process || dependent.isDetached) {
+            qWarning() << app.definition.id << "意外退出，" << dependent.definition.id << "可能无法正常工作";
+        } else {
+            qWarning() << app.definition.id << "意外退出，" << dependent.definition.id << "启动中止";
+        }
+    }
+    
+    // 就绪前退出视为启动失败（会一并中止等待它的启动）；否则清理进程组中残留的子进程
+    if (!app.isReady) {
+        failLaunch(index, QString("%1在就绪前退出（%2）").arg(app.definition.label)
+                   .arg(exitStatus == QProcess::CrashExit ? QString("异常终止") : QString("退出代码 %1").arg(exitCode)));
+        return;
+    }
+    
+    // 运行中崩溃：按重启策略在清理完成后重启
+    QString reason;
+    app.restartPending = shouldRestart(index, exitCode, exitStatus, &reason);
+    m_launchTimeline->finish(app.definition.id, "crashed");
+    stopApplication(index);
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (isLaunching(i) && !m_applications[i].process && m_applications[i].definition.dependencies.contains(index)) {
+            failLaunch(i, QString());
+        }
+    }
+    if (!reason.isEmpty()) {
+        qWarning() << reason;
+        emit restartAbandoned(index, reason);
+    }
+}
+
+void Supervisor::stopApplication(int index)
+{
+    AppProcess &app = m_applications[index];
+    const QString &appId = app.definition.id;
+    
+    if (m_daemon) {
+        m_daemon->send("stop " + appId);
+        return;
+    }
+    
+    if (isRestartScheduled(index)) {
+        // 等待重启期间停止即取消重启，同时释放为其保留的依赖
+        qDebug() << "取消" << appId << "的自动重启";
+        app.restartTimer->stop();
+        stopOwnedDependencies(index);
+        emit stateChanged();
+        return;
+    }
+    
+    if (!app.isRunning) {
+        qDebug() << appId << "未在运行";
+        return;
+    }
+    
+    if (app.isStopping) {
+        qDebug() << appId << "正在停止中";
+        return;
+    }
+    
+    qDebug() << "停止" << appId;
+    
+    // 取消尚未完成的就绪等待
+    if (app.probe) {
+        app.probe->cancel();
+    }
+    
+    // 停止策略：向进程组发送SIGTERM → 超时后SIGKILL → 确认进程组消失，全部异步执行
+    // 复用的已有实例不由启动器启动，计划为空，不会被结束
+    AppStopper::Plan plan;
+    plan.processGroupIds = app.processGroupIds;
+    plan.terminateTimeout = app.definition.stopTimeout;
+    if (app.isDetached) {
+        // 终端会把子进程放入自己的会话，只能按模式清理
+        plan.sweepPatterns = app.definition.terminalSweepPatterns;
+    }
+    
+    AppStopper *stopper = new AppStopper(appId, app.process, plan, this);
+    connect(stopper, &AppStopper::finished, this, &Supervisor::onApplicationStopped);
+    app.isStopping = true;
+    m_activeStoppers++;
+    emit stateChanged();
+    
+    // 崩溃重启时保留依赖（例如roscore），重启后直接复用
+    if (!app.restartPending) {
+        stopOwnedDependencies(index);
+    }
+    
+    stopper->start();
+}
+
+void Supervisor::stopOwnedDependencies(int index)
+{
+    // 为本应用启动的依赖，在没有其他运行中的应用使用时一并（并发）停止
+    const QList<int> ownedDependencies = m_applications[index].ownedDependencies;
+    m_applications[index].ownedDependencies.clear();
+    for (int dependency : ownedDependencies) {
+        bool inUse = false;
+        for (int i = 0; i < m_applications.size(); ++i) {
+            const AppProcess &other = m_applications[i];
+            if (i != index && other.isRunning && !other.isStopping
+                    && other.definition.dependencies.contains(dependency)) {
+                inUse = true;
+                break;
+            }
+        }
+        if (!inUse) {
+            stopApplication(dependency);
+        }
+    }
+}
+
+void Supervisor::onApplicationStopped(const QString &appId, bool forced)
+{
+    m_activeStoppers--;
+    
+    int index = m_applicationIndex.value(appId, -1);
+    if (index >= 0) {
+        AppProcess &app = m_applications[index];
+        app.isRunning = false;
+        app.isStopping = false;
+        app.isDetached = false;
+        app.isReady = false;
+        app.isExternal = false;
+        if (app.detachedPid > 0) {
+            m_exitWatcher->unwatch(app.detachedPid);
+            app.detachedPid = 0;
+        }
+        app.processGroupIds.clear();
+        m_resourceMonitor->untrack(appId);
+        m_cgroupManager->releaseApplicationGroup(appId);
+        m_launchTimeline->finish(appId, "stopped");
+        qDebug() << appId << "已停止" << (forced ? "（强制）" : "");
+        if (app.restartPending) {
+            app.restartPending = false;
+            scheduleRestart(index);
+        }
+        emit applicationStopped(appId);
+    }
+    
+    emit stateChanged();
+    
+    if (m_activeStoppers == 0) {
+        emit allApplicationsStopped();
+    }
+}
+
+void Supervisor::stopAllApplications()
+{
+    qDebug() << "停止所有应用程序...";
+    
+    if (m_daemon) {
+        m_daemon->send("stop-all");
+        return;
+    }
+    
+    // 所有运行中的应用程序并发停止，完成后发出allApplicationsStopped
+    for (int i = 0; i < m_applications.size(); ++i) {
+        if (m_applications[i].isRunning || isRestartScheduled(i)) {
+            stopApplication(i);
+        }
+    }
+    
+    if (m_activeStoppers == 0) {
+        emit allApplicationsStopped();
+    }
+}
+
+void Supervisor::killAllApplicationsNow()
+{
+    // 委托模式下的进程组属于守护进程，不由启动器结束
+    if (m_daemon) {
+        return;
+    }
+    
+    // 析构时无法等待异步流程：直接向各进程组发送SIGKILL
+    for (AppProcess &app : m_applications) {
+#ifdef Q_OS_UNIX
+        for (qint64 processGroupId : app.processGroupIds) {
+            // kill(0)和kill(-1)会波及启动器自己的进程组乃至所有进程
+            if (processGroupId <= 0) {
+                continue;
+            }
+            qDebug() << "强制结束" << app.definition.id << "，进程组:" << processGroupId;
+            ::kill(static_cast<pid_t>(-processGroupId), SIGKILL);
+        }
+        app.processGroupIds.clear();
+#endif
+        if (app.process && app.process->state() != QProcess::NotRunning) {
+            app.process->kill();
+        }
+        
+        // 终端分离启动的应用无法跟踪进程组，只能按模式清理
+        if (app.isDetached && app.isRunning) {
+            for (const QString &pattern : app.definition.terminalSweepPatterns) {
+                QProcess::startDetached("pkill", QStringList() << "-f" << pattern);
+            }
+        }
+        app.isRunning = false;
+    }
+}
+
+void Supervisor::notifyWindowFound(int index)
+{
+    // 以窗口映射作为就绪条件的应用，此时才推进依赖它的启动
+    AppProcess &app = m_applications[index];
+    if (app.isRunning && !app.isReady && app.probe && app.probe->kind() == ReadinessProbe::Kind::Event) {
+        app.probe->notify();
+    }
+}
+
+void Supervisor::attachDetachedProcess(int index, qint64 pid)
+{
+    AppProcess &app = m_applications[index];
+    if (!app.isDetached || app.detachedPid > 0 || pid <= 0) {
+        return;
+    }
+    
+    // 终端启动的进程不是启动器的子进程，只能通过窗口的_NET_WM_PID得知其退出
+    app.detachedPid = pid;
+    m_exitWatcher->watch(pid);
+    // 终端中的命令与bash同属一个进程组，整组计入该应用
+    QList<qint64> processGroupIds;
+#ifdef Q_OS_UNIX
+    pid_t processGroupId = ::getpgid(static_cast<pid_t>(pid));
+    if (processGroupId > 0) {
+        processGroupIds << processGroupId;
+    }
+#endif
+    m_resourceMonitor->track(app.definition.id, processGroupIds, pid);
+}
+
+void Supervisor::onDetachedProcessExited(qint64 pid)
+{
+    for (int i = 0; i < m_applications.size(); ++i) {
+        AppProcess &app = m_applications[i];
+        if (app.detachedPid != pid) {
+            continue;
+        }
+        
+        app.detachedPid = 0;
+        if (app.isRunning && !app.isStopping) {
+            // 主窗口进程已退出，清理终端中残留的roscore等进程
+            qDebug() << app.definition.id << "进程已退出（终端启动），清理残留进程";
+            stopApplication(i);
+        }
+        break;
+    }
+}
+
+bool Supervisor::isApplicationRunning(int index) const
+{
+    // 运行状态由启动流程（包括等待依赖和就绪期间）和进程结束信号维护；等待崩溃重启也视为运行中
+    return m_applications[index].isRunning || isRestartScheduled(index);
+}
+
+bool Supervisor::isLaunching(int index) const
+{
+    const AppProcess &app = m_applications[index];
+    return app.isRunning && !app.isStopping && !app.isReady;
+}
+
+bool Supervisor::isRestartScheduled(int index) const
+{
+    const AppProcess &app = m_applications[index];
+    return app.daemonRestartScheduled || (app.restartTimer && app.restartTimer->isActive());
+}
+
+bool Supervisor::shouldRestart(int index, int exitCode, QProcess::ExitStatus exitStatus, QString *reason)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition::RestartPolicy &policy = app.definition.restart;
+    
+    // 正常退出（例如用户关闭了窗口）不重启
+    bool crashed = (exitStatus == QProcess::CrashExit || exitCode != 0);
+    if (!policy.enabled || !crashed || m_shuttingDown) {
+        return false;
+    }
+    
+    // 崩溃循环：每次都在启动后不久退出，重启无济于事
+    if (app.uptime.isValid() && app.uptime.elapsed() >= policy.minUptime) {
+        app.consecutiveCrashes = 0;
+    }
+    app.consecutiveCrashes++;
+    if (app.consecutiveCrashes >= policy.crashLoopThreshold) {
+        app.crashLoop = true;
+        *reason = QString("%1连续%2次在启动后%3秒内退出，已停止自动重启。\n\n上次退出: %4")
+                .arg(app.definition.label).arg(app.consecutiveCrashes).arg(policy.minUptime / 1000)
+                .arg(exitStatus == QProcess::CrashExit ? QString("异常终止") : QString("退出代码 %1").arg(exitCode));
+        return false;
+    }
+    
+    // 重启预算：只统计窗口时间内的重启
+    qint64 now = m_supervisionClock.elapsed();
+    while (!app.restartTimes.isEmpty() && now - app.restartTimes.first() > policy.window) {
+        app.restartTimes.removeFirst();
+    }
+    if (app.restartTimes.size() >= policy.maxRestarts) {
+        *reason = QString("%1在%2分钟内已自动重启%3次，不再自动重启。")
+                .arg(app.definition.label).arg(policy.window / 60000).arg(app.restartTimes.size());
+        return false;
+    }
+    return true;
+}
+
+void Supervisor::scheduleRestart(int index)
+{
+    AppProcess &app = m_applications[index];
+    const AppDefinition::RestartPolicy &policy = app.definition.restart;
+    
+    // 指数退避：连续崩溃次数越多等待越久，稳定运行后清零
+    qint64 delay = policy.initialDelay;
+    for (int i = 1; i < app.consecutiveCrashes && delay < policy.maxDelay; ++i) {
+        delay *= 2;
+    }
+    delay = qMin<qint64>(delay, policy.maxDelay);
+    
+    if (!app.restartTimer) {
+        app.restartTimer = new QTimer(this);
+        app.restartTimer->setSingleShot(true);
+        connect(app.restartTimer, &QTimer::timeout, this, [this, index]() { restartApplication(index); });
+    }
+    app.restartTimer->start(static_cast<int>(delay));
+    qDebug() << app.definition.id << "将在" << delay << "毫秒后自动重启";
+    emit stateChanged();
+}
+
+void Supervisor::restartApplication(int index)
+{
+    AppProcess &app = m_applications[index];
+    if (m_shuttingDown || app.isRunning) {
+        return;
+    }
+    
+    app.restartTimes << m_supervisionClock.elapsed();
+    app.restartCount++;
+    qDebug() << "自动重启" << app.definition.id << "（第" << app.restartCount << "次）";
+    
+    // ROS环境和程序路径均已缓存，依赖在等待期间保持运行，重启只需fork/exec
+    const QList<int> ownedDependencies = app.ownedDependencies;
+    m_launchTimeline->begin(app.definition.id);
+    startApplication(index);
+    for (int dependency : ownedDependencies) {
+        if (!app.ownedDependencies.contains(dependency)) {
+            app.ownedDependencies << dependency;
+        }
+    }
+}
+
+QString Supervisor::supervisionSummary(int index) const
+{
+    const AppProcess &app = m_applications[index];
+    if (!app.hasExited && app.restartCount == 0) {
+        return QString();
+    }
+    
+    QStringList lines;
+    lines << QString("自动重启: %1 次").arg(app.restartCount);
+    if (app.hasExited) {
+        lines << QString("上次退出: %1").arg(app.lastExitCrashed
+                ? QString("异常终止") : QString("退出代码 %1").arg(app.lastExitCode));
+    }
+    if (app.crashLoop) {
+        lines << "检测到崩溃循环，已停止自动重启";
+    }
+    return lines.join("\n");
+}
+
+void Supervisor::start(int index)
+{
+    // 手动启动重新开始计算崩溃循环和重启预算
+    AppProcess &app = m_applications[index];
+    if (m_daemon) {
+        startApplication(index);
+        return;
+    }
+    app.crashLoop = false;
+    app.consecutiveCrashes = 0;
+    app.restartTimes.clear();
+    m_launchTimeline->begin(app.definition.id);
+    startApplication(index);
+}
+
+void Supervisor::stop(int index)
+{
+    stopApplication(index);
+}
+
+void Supervisor::stopProfile(int profileIndex)
+{
+    for (int index : m_registry.profiles()[profileIndex].members) {
+        if (m_applications[index].isRunning) {
+            stopApplication(index);
+        }
+    }
+}
+
+void Supervisor::shutdown()
+{
+    m_shuttingDown = true;
+    if (m_daemon) {
+        // 应用程序由守护进程继续监管，关闭界面时不停止
+        QTimer::singleShot(0, this, &Supervisor::allApplicationsStopped);
+        return;
+    }
+    stopAllApplications();
+}
+
+bool Supervisor::startApplication(const QString &appId)
+{
+    int index = m_applicationIndex.value(appId, -1);
+    if (index < 0) {
+        return false;
+    }
+    if (!isApplicationRunning(index) && !m_shuttingDown) {
+        start(index);
+    }
+    return true;
+}
+
+bool Supervisor::stopApplication(const QString &appId)
+{
+    int index = m_applicationIndex.value(appId, -1);
+    if (index < 0) {
+        return false;
+    }
+    if (isApplicationRunning(index)) {
+        stopApplication(index);
+    }
+    return true;
+}
+
+bool Supervisor::startProfile(const QString &profileId)
+{
+    int profileIndex = m_registry.profileIndexOf(profileId);
+    if (profileIndex < 0) {
+        qWarning() << "未定义的启动配置:" << profileId;
+        return false;
+    }
+    
+    // 所有成员同时进入启动流程：互不依赖的立即并行启动，
+    // 有依赖的各自等待依赖就绪（共享的依赖如roscore只启动一次）
+    const LaunchProfile &profile = m_registry.profiles()[profileIndex];
+    if (m_daemon) {
+        m_daemon->send("profile " + profile.id);
+        return true;
+    }
+    qDebug() << "启动配置" << profile.id << ":" << profile.applications;
+    for (int index : profile.members) {
+        if (!m_applications[index].isRunning) {
+            m_launchTimeline->begin(m_applications[index].definition.id);
+            startApplication(index);
+        }
+    }
+    return true;
+}
+
+bool Supervisor::isProfileRunning(int profileIndex) const
+{
+    for (int index : m_registry.profiles()[profileIndex].members) {
+        if (isApplicationRunning(index)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Supervisor::isProfileStopping(int profileIndex) const
+{
+    for (int index : m_registry.profiles()[profileIndex].members) {
+        if (m_applications[index].isStopping) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QJsonObject Supervisor::statusReport() const
+{
+    QJsonArray applications;
+    for (int i = 0; i < m_applications.size(); ++i) {
+        const AppProcess &app = m_applications[i];
+        QString state = "stopped";
+        if (app.isStopping) {
+            state = "stopping";
+        } else if (isRestartScheduled(i)) {
+            state = "restarting";
+        } else if (isLaunching(i)) {
+            state = "starting";
+        } else if (app.isRunning) {
+            state = "running";
+        }
+        
+        QJsonObject entry;
+        entry.insert("id", app.definition.id);
+        entry.insert("state", state);
+        entry.insert("external", app.isExternal);
+        entry.insert("restarts", app.restartCount);
+        qint64 pid = app.process ? app.process->processId() : qMax(app.detachedPid, app.daemonPid);
+        if (pid > 0) {
+            entry.insert("pid", pid);
+        }
+        QJsonArray processGroups;
+        for (qint64 processGroupId : app.processGroupIds) {
+            processGroups.append(processGroupId);
+        }
+        entry.insert("process_groups", processGroups);
+        ResourceSample sample;
+        if (m_resourceMonitor->latest(app.definition.id, &sample)) {
+            entry.insert("cpu", sample.cpuPercent);
+            entry.insert("rss", sample.rssBytes);
+        }
+        applications.append(entry);
+    }
+    
+    QJsonArray profiles;
+    for (int i = 0; i < m_registry.profiles().size(); ++i) {
+        QJsonObject entry;
+        entry.insert("id", m_registry.profiles()[i].id);
+        entry.insert("running", isProfileRunning(i));
+        profiles.append(entry);
+    }
+    
+    QJsonObject report;
+    report.insert("applications", applications);
+    report.insert("profiles", profiles);
+    return report;
+}
+
+bool Supervisor::attachToDaemon(const QString &socketPath, QString *error)
+{
+    DaemonConnection *daemon = new DaemonConnection(this);
+    connect(daemon, &DaemonConnection::statusReceived, this, &Supervisor::onDaemonStatus);
+    connect(daemon, &DaemonConnection::eventReceived, this, &Supervisor::onDaemonEvent);
+    connect(daemon, &DaemonConnection::disconnected, this, &Supervisor::onDaemonDisconnected);
+    if (!daemon->open(socketPath, error)) {
+        delete daemon;
+        return false;
+    }
+    m_daemon = daemon;
+    qDebug() << "应用程序由监管守护进程监管:" << socketPath;
+    return true;
+}
+
+void Supervisor::onDaemonStatus(const QJsonObject &status)
+{
+    // 守护进程使用不同注册表时，只显示两边都有的应用程序
+    const QJsonArray applications = status.value("applications").toArray();
+    for (const QJsonValue &value : applications) {
+        const QJsonObject entry = value.toObject();
+        int index = indexOf(entry.value("id").toString());
+        if (index >= 0) {
+            applyDaemonEntry(index, entry);
+        }
+    }
+    emit stateChanged();
+}
+
+void Supervisor::onDaemonEvent(const QJsonObject &event)
+{
+    int index = indexOf(event.value("id").toString());
+    if (index < 0) {
+        return;
+    }
+    const QString name = event.value("event").toString();
+    if (name == "launchFailed") {
+        emit launchFailed(index, event.value("message").toString());
+    } else if (name == "restartAbandoned") {
+        emit restartAbandoned(index, event.value("reason").toString());
+    }
+}
+
+void Supervisor::onDaemonDisconnected()
+{
+    qWarning() << "与监管守护进程的连接已断开，不再显示其应用程序状态";
+    for (int i = 0; i < m_applications.size(); ++i) {
+        applyDaemonEntry(i, QJsonObject());
+    }
+    emit stateChanged();
+}
+
+void Supervisor::applyDaemonEntry(int index, const QJsonObject &entry)
+{
+    AppProcess &app = m_applications[index];
+    const QString state = entry.value("state").toString();
+    bool wasActive = app.isRunning;
+    app.isStopping = (state == "stopping");
+    app.isRunning = app.isStopping || state == "starting" || state == "running";
+    app.isReady = (state == "running");
+    app.isExternal = entry.value("external").toBool();
+    app.daemonRestartScheduled = (state == "restarting");
+    app.restartCount = entry.value("restarts").toInt(app.restartCount);
+    
+    // 同一用户的进程：资源占用在本地采样，进程组用于按_NET_WM_PID匹配窗口
+    QList<qint64> processGroupIds;
+    for (const QJsonValue &value : entry.value("process_groups").toArray()) {
+        qint64 processGroupId = static_cast<qint64>(value.toDouble());
+        if (processGroupId > 0) {
+            processGroupIds << processGroupId;
+        }
+    }
+    qint64 pid = static_cast<qint64>(entry.value("pid").toDouble());
+    if (processGroupIds != app.processGroupIds || pid != app.daemonPid) {
+        app.processGroupIds = processGroupIds;
+        app.daemonPid = pid;
+        if (processGroupIds.isEmpty() && pid <= 0) {
+            m_resourceMonitor->untrack(app.definition.id);
+        } else {
+            m_resourceMonitor->track(app.definition.id, processGroupIds, pid);
+        }
+    }
+    
+    if (!wasActive && app.isRunning && app.definition.hasWindow() && m_windowManagementAvailable) {
+        // 守护进程无法观察窗口，由界面查找并最大化
+        emit windowSearchRequested(index);
+    } else if (wasActive && !app.isRunning) {
+        emit applicationStopped(app.definition.id);
+    }
+}
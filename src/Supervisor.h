@@ -0,0 +1,217 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <QObject>
+#include <QProcess>
+#include <QHash>
+#include <QVector>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QProcessEnvironment>
+#include "AppRegistry.h"
+#include "ManagedProcess.h"
+
+class RosEnvironment;
+class ReadinessProbe;
+class LaunchTimeline;
+class ProcessExitWatcher;
+class AppImagePrewarmer;
+class ExecutableLocator;
+class ResourceMonitor;
+class CgroupManager;
+class DaemonConnection;
+
+/**
+ * @brief 应用程序监管核心（不依赖界面）
+ *
+ * 按注册表启动、停止和监管应用程序：ROS环境 → 依赖 → 启动进程 → 就绪探测，
+ * 崩溃后按重启策略重启，并采样资源占用。只需要QCoreApplication，
+ * 浮动启动器（FlightControlsLauncher）和无界面的flight_controls_supervisord都以它为核心，
+ * 界面只负责按钮、状态显示和窗口管理。
+ * 守护进程已在运行时，浮动启动器的Supervisor改为委托模式（attachToDaemon）：
+ * 状态来自守护进程的推送，控制命令转发给守护进程，进程资源仍在本地采样。
+ * 所有接口按注册表下标访问；控制套接字使用按id的接口
+ */
+class Supervisor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Supervisor(const AppRegistry &registry, QObject *parent = nullptr);
+    ~Supervisor();
+
+    static constexpr int PROCESS_KILL_TIMEOUT = 3000;   // 毫秒
+    static constexpr int PREWARM_DELAY = 3000;          // 延迟开始预热，避免与启动器自身启动争抢IO
+
+    // 注册表
+    int applicationCount() const { return m_applications.size(); }
+    const AppDefinition &definition(int index) const { return m_applications[index].definition; }
+    int indexOf(const QString &appId) const { return m_applicationIndex.value(appId, -1); }
+    const QVector<LaunchProfile> &profiles() const { return m_registry.profiles(); }
+
+    // 按下标的控制（界面按钮）：手动启动会重新计算崩溃循环和重启预算
+    void start(int index);
+    void stop(int index);
+    void stopProfile(int profileIndex);
+
+    // 按id的控制（命令行和控制套接字）：未定义的id返回false
+    bool startApplication(const QString &appId);
+    bool stopApplication(const QString &appId);
+    bool startProfile(const QString &profileId);   // 无依赖的成员并行启动
+    void stopAllApplications();                     // 并发停止，完成后发出allApplicationsStopped
+    void shutdown();                                // 不再自动重启并停止所有应用程序（退出前）
+    void killAllApplicationsNow();                  // 析构时使用的非阻塞强制清理
+
+    // 启用预热：空闲后在后台解包声明了prewarm的AppImage并预读，之后直接启动解包后的程序
+    void enablePrewarm();
+
+    // 委托模式：必须在启动任何应用程序之前调用；之后shutdown()不停止守护进程监管的应用程序
+    bool attachToDaemon(const QString &socketPath, QString *error);
+    bool isAttachedToDaemon() const { return m_daemon != nullptr; }
+
+    // 状态
+    bool isApplicationRunning(int index) const;     // 启动中、运行中或等待崩溃重启
+    bool isActive(int index) const { return m_applications[index].isRunning; }  // 启动流程进行中或正在运行
+    bool isLaunching(int index) const;              // 已请求启动但尚未就绪
+    bool isReady(int index) const { return m_applications[index].isReady; }
+    bool isStopping(int index) const { return m_applications[index].isStopping; }
+    bool isDetached(int index) const { return m_applications[index].isDetached; }
+    bool isRestartScheduled(int index) const;
+    bool isProfileRunning(int profileIndex) const;  // 任一成员在运行
+    bool isProfileStopping(int profileIndex) const; // 任一成员正在停止
+    bool isShuttingDown() const { return m_shuttingDown; }
+    int restartCount(int index) const { return m_applications[index].restartCount; }
+    QList<qint64> processGroupIds(int index) const { return m_applications[index].processGroupIds; }
+    QString supervisionSummary(int index) const;    // 重启次数和上次退出代码
+    QJsonObject statusReport() const;               // 各应用和启动配置的状态（控制套接字status）
+
+    // 窗口管理（由界面提供）：不可用时以窗口为就绪条件的应用在进程启动后即视为就绪
+    void setWindowManagementAvailable(bool available) { m_windowManagementAvailable = available; }
+    void notifyWindowFound(int index);                  // 满足"window"就绪条件
+    void attachDetachedProcess(int index, qint64 pid);  // 终端启动的应用：由窗口_NET_WM_PID得到的主进程
+
+    LaunchTimeline *launchTimeline() const { return m_launchTimeline; }
+    ResourceMonitor *resourceMonitor() const { return m_resourceMonitor; }
+
+signals:
+    void stateChanged();                                        // 任一应用的状态变化
+    void launchFailed(int index, const QString &message);
+    void restartAbandoned(int index, const QString &reason);    // 预算耗尽或崩溃循环，不再自动重启
+    void windowSearchRequested(int index);                      // 界面开始查找并最大化该应用的窗口
+    void applicationStopped(const QString &appId);              // 单个应用程序的停止流程已完成
+    void allApplicationsStopped();                              // 所有进行中的停止流程均已完成
+
+private slots:
+    void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onApplicationStopped(const QString &appId, bool forced);  // 异步停止流程完成
+    void onRosEnvironmentReady();                    // ROS环境解析完成，继续等待中的启动
+    void onRosEnvironmentFailed(const QString &reason); // ROS环境解析失败，回退到终端启动
+    void onDetachedProcessExited(qint64 pid);        // 终端启动的应用程序已退出
+    void onDaemonStatus(const QJsonObject &status);  // 委托模式：守护进程推送的状态
+    void onDaemonEvent(const QJsonObject &event);
+    void onDaemonDisconnected();
+
+private:
+    // 启动流程
+    void startApplication(int index);
+    void continueLaunch(int index);       // 推进启动流程：ROS环境 → 依赖就绪 → 启动进程 → 就绪探测
+    bool spawnApplication(int index);
+    void failLaunch(int index, const QString &message);
+    void markReady(int index);
+    void stopApplication(int index);
+    void stopOwnedDependencies(int index);  // 停止为该应用启动且不再被使用的依赖
+
+    // 崩溃自动重启：决定是否重启（预算和崩溃循环检测），清理完成后按指数退避重启
+    bool shouldRestart(int index, int exitCode, QProcess::ExitStatus exitStatus, QString *reason);
+    void scheduleRestart(int index);
+    void restartApplication(int index);
+
+    // 程序路径：预热缓存 → 搜索路径缓存 → ROS/系统PATH
+    QString resolveProgram(int index);
+    QProcessEnvironment applicationEnvironment(int index) const;
+    ManagedProcess::SchedulingPolicy schedulingPolicy(int index);  // 注册表中的资源策略（按需创建cgroup子组）
+
+    // 就绪探测（端口、文件、日志行或窗口），就绪后立即推进依赖它的启动和窗口搜索
+    void startReadinessProbe(int index, bool checkOnly);
+    void onReadinessProbeReady(int index);
+    void onReadinessProbeTimeout(int index);
+
+    // 终端回退启动（ROS环境无法解析时）
+    void startInTerminal(int index);
+    bool resolveTerminal(int index);  // 首次回退到终端启动时才查找终端程序
+
+    // 委托模式：按守护进程报告的状态更新（空条目表示已停止）
+    void applyDaemonEntry(int index, const QJsonObject &entry);
+
+    // 应用程序运行状态（与注册表下标一一对应）
+    struct AppProcess {
+        AppDefinition definition;
+        ManagedProcess *process = nullptr;
+        QList<qint64> processGroupIds;             // 受管进程的进程组ID（为空表示无法跟踪）
+        QList<int> ownedDependencies;              // 为该应用启动的依赖，随其一起停止
+        bool isDetached = false;                   // 通过终端分离启动，只能按模式清理
+        qint64 detachedPid = 0;                    // 分离启动时由窗口_NET_WM_PID得到的主进程（未知时为0）
+        bool isRunning = false;                    // 启动流程进行中或正在运行
+        bool isStopping = false;                   // 异步停止流程进行中
+        bool isReady = false;                      // 就绪探测已通过
+        bool isExternal = false;                   // 使用已有的实例（reuseExisting），不由启动器启动
+        bool existingChecked = false;              // 本次启动已检查过是否有现成实例
+        bool probeCheckOnly = false;               // 当前探测是否只检查现成实例
+        ReadinessProbe *probe = nullptr;
+        ExecutableLocator *locator = nullptr;      // 声明了searchPaths时的路径缓存
+        AppImagePrewarmer *prewarmer = nullptr;    // 预热启用时创建
+        QString terminalProgram;                   // 终端回退启动的命令（首次使用时解析）
+        QStringList terminalArguments;
+
+        // 崩溃重启状态
+        QTimer *restartTimer = nullptr;            // 退避定时器（首次重启时创建）
+        QElapsedTimer uptime;                      // 本次进程已运行的时间
+        QList<qint64> restartTimes;                // 预算窗口内的重启时间（m_supervisionClock毫秒）
+        int restartCount = 0;                      // 累计自动重启次数
+        int consecutiveCrashes = 0;                // 连续的短时间崩溃次数
+        int lastExitCode = 0;
+        bool hasExited = false;                    // 是否记录过退出信息
+        bool lastExitCrashed = false;
+        bool restartPending = false;               // 停止流程完成后安排重启
+        bool crashLoop = false;                    // 已判定为崩溃循环，停止自动重启
+
+        // 委托模式下由守护进程报告
+        bool daemonRestartScheduled = false;
+        qint64 daemonPid = 0;
+    };
+
+    QVector<AppProcess> m_applications;
+    QHash<QString, int> m_applicationIndex;
+    AppRegistry m_registry;   // 启动配置按id查找
+
+    // 异步停止
+    int m_activeStoppers;         // 进行中的停止流程数量
+    bool m_shuttingDown;          // 退出前停止所有应用，不再自动重启
+
+    bool m_windowManagementAvailable;
+
+    // 崩溃重启的预算窗口计时
+    QElapsedTimer m_supervisionClock;
+
+    // ROS受管启动
+    RosEnvironment *m_rosEnvironment;  // 缓存的ROS环境
+
+    // 启动耗时记录（点击 → 进程启动 → 窗口出现 → 最大化）
+    LaunchTimeline *m_launchTimeline;
+
+    // 非子进程的退出通知（pidfd），状态完全由事件驱动
+    ProcessExitWatcher *m_exitWatcher;
+
+    // 受管进程树的CPU、内存和IO采样（后台线程）
+    ResourceMonitor *m_resourceMonitor;
+
+    // 启动器所属的cgroup v2子树（cpuMax/memoryMax）
+    CgroupManager *m_cgroupManager;
+
+    // 委托模式下到守护进程的连接（本地监管时为空）
+    DaemonConnection *m_daemon;
+};
+
+#endif // SUPERVISOR_H
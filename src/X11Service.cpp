@@ -0,0 +1,174 @@
+#include "X11Service.h"
+#include "StartupTrace.h"
+#include <QByteArray>
+#include <QDebug>
+
+#ifdef FLIGHTCONTROLS_HAVE_X11EXTRAS
+#include <QX11Info>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <xcb/xcb.h>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+X11Service::X11Service(QObject *parent)
+    : QObject(parent)
+    , m_connection(nullptr)
+    , m_requestConnection(nullptr)
+    , m_root(0)
+    , m_atoms()
+{
+#ifdef Q_OS_LINUX
+    int screenNumber = 0;
+    StartupTrace::begin("xcb_connect");
+    xcb_connection_t *connection = xcb_connect(nullptr, &screenNumber);
+    StartupTrace::end("xcb_connect");
+    if (xcb_connection_has_error(connection)) {
+        // 失败时仍返回连接对象，需要释放
+        xcb_disconnect(connection);
+        qWarning() << "无法连接到X11显示服务器，窗口管理功能可能不可用";
+        return;
+    }
+    m_connection = connection;
+    qDebug() << "X11显示服务器连接成功";
+
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(m_connection));
+    for (int i = 0; i < screenNumber && screens.rem > 0; ++i) {
+        xcb_screen_next(&screens);
+    }
+    m_root = screens.data->root;
+
+    m_requestConnection = m_connection;
+#ifdef FLIGHTCONTROLS_HAVE_X11EXTRAS
+    if (QX11Info::isPlatformX11() && QX11Info::connection()) {
+        m_requestConnection = QX11Info::connection();
+        qDebug() << "窗口操作使用Qt的X11连接";
+    }
+#endif
+
+    // 所有原子的请求先全部发出，再依次取回复（原子在服务器范围内有效，两个连接通用）
+    QByteArray compositingSelection = "_NET_WM_CM_S" + QByteArray::number(screenNumber);
+    const char *names[AtomCount] = {
+        "_NET_WM_STATE",
+        "_NET_WM_STATE_MAXIMIZED_HORZ",
+        "_NET_WM_STATE_MAXIMIZED_VERT",
+        "_NET_ACTIVE_WINDOW",
+        "_NET_CLIENT_LIST",
+        "_NET_WM_NAME",
+        "_NET_WM_PID",
+        compositingSelection.constData()
+    };
+    StartupTrace::begin("xcb_intern_atom");
+    xcb_intern_atom_cookie_t cookies[AtomCount];
+    for (int i = 0; i < AtomCount; ++i) {
+        cookies[i] = xcb_intern_atom(m_connection, 0, static_cast<uint16_t>(strlen(names[i])), names[i]);
+    }
+    for (int i = 0; i < AtomCount; ++i) {
+        xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(m_connection, cookies[i], nullptr);
+        if (reply) {
+            m_atoms[i] = reply->atom;
+            free(reply);
+        }
+    }
+    StartupTrace::end("xcb_intern_atom");
+#endif
+}
+
+X11Service::~X11Service()
+{
+#ifdef Q_OS_LINUX
+    // Qt的连接由Qt关闭
+    if (m_connection) {
+        xcb_disconnect(m_connection);
+        m_connection = nullptr;
+    }
+#endif
+}
+
+bool X11Service::isCompositing() const
+{
+#ifdef Q_OS_LINUX
+    if (!m_connection) {
+        return false;
+    }
+    xcb_get_selection_owner_reply_t *reply = xcb_get_selection_owner_reply(
+        m_connection, xcb_get_selection_owner(m_connection, m_atoms[NetWmCmScreen]), nullptr);
+    bool compositing = reply && reply->owner != XCB_NONE;
+    free(reply);
+    return compositing;
+#else
+    return true;
+#endif
+}
+
+void X11Service::sendRootMessage(unsigned long windowId, unsigned long messageType, long data0, long data1, long data2)
+{
+#ifdef Q_OS_LINUX
+    // xcb_send_event固定发送32字节，与xcb_client_message_event_t大小一致
+    xcb_client_message_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.response_type = XCB_CLIENT_MESSAGE;
+    event.window = windowId;
+    event.type = messageType;
+    event.format = 32;
+    event.data.data32[0] = static_cast<uint32_t>(data0);
+    event.data.data32[1] = static_cast<uint32_t>(data1);
+    event.data.data32[2] = static_cast<uint32_t>(data2);
+
+    xcb_send_event(m_requestConnection, 0, m_root,
+                   XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT | XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY,
+                   reinterpret_cast<const char *>(&event));
+#else
+    Q_UNUSED(windowId)
+    Q_UNUSED(messageType)
+    Q_UNUSED(data0)
+    Q_UNUSED(data1)
+    Q_UNUSED(data2)
+#endif
+}
+
+void X11Service::maximizeWindow(unsigned long windowId)
+{
+#ifdef Q_OS_LINUX
+    if (!m_requestConnection || windowId == 0) {
+        return;
+    }
+
+    // _NET_WM_STATE_ADD（1）水平和垂直最大化
+    sendRootMessage(windowId, m_atoms[NetWmState], 1,
+                    static_cast<long>(m_atoms[NetWmStateMaximizedHorz]),
+                    static_cast<long>(m_atoms[NetWmStateMaximizedVert]));
+    qDebug() << "设置窗口最大化:" << windowId;
+#else
+    Q_UNUSED(windowId)
+#endif
+}
+
+void X11Service::activateWindow(unsigned long windowId)
+{
+#ifdef Q_OS_LINUX
+    if (!m_requestConnection || windowId == 0) {
+        return;
+    }
+
+    const uint32_t stackMode = XCB_STACK_MODE_ABOVE;
+    xcb_configure_window(m_requestConnection, windowId, XCB_CONFIG_WINDOW_STACK_MODE, &stackMode);
+    xcb_set_input_focus(m_requestConnection, XCB_INPUT_FOCUS_POINTER_ROOT, windowId, XCB_CURRENT_TIME);
+    // 来源2表示来自应用程序的请求
+    sendRootMessage(windowId, m_atoms[NetActiveWindow], 2, XCB_CURRENT_TIME, 0);
+    qDebug() << "窗口已置前:" << windowId;
+#else
+    Q_UNUSED(windowId)
+#endif
+}
+
+void X11Service::flush()
+{
+#ifdef Q_OS_LINUX
+    if (m_requestConnection) {
+        xcb_flush(m_requestConnection);
+    }
+#endif
+}
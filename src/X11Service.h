@@ -0,0 +1,58 @@
+#ifndef X11SERVICE_H
+#define X11SERVICE_H
+
+#include <QObject>
+
+// XCB前置声明（非Linux平台下仅作占位类型）
+typedef struct xcb_connection_t xcb_connection_t;
+
+/**
+ * @brief 启动器共用的X11（XCB）连接和原子缓存
+ *
+ * 启动时打开一次连接，所有用到的原子的xcb_intern_atom请求一起发出后再统一取回复（一次往返），
+ * 之后最大化、置前等窗口操作都只是异步请求，不再有阻塞的往返。
+ * 构建时找到QtX11Extras时，窗口操作通过Qt自己的XCB连接发送；
+ * 根窗口事件需要独立的事件队列，X11WindowWatcher始终使用eventConnection()
+ */
+class X11Service : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum AtomName {
+        NetWmState,
+        NetWmStateMaximizedHorz,
+        NetWmStateMaximizedVert,
+        NetActiveWindow,
+        NetClientList,
+        NetWmName,
+        NetWmPid,
+        NetWmCmScreen,       // _NET_WM_CM_S<屏幕号>，合成器持有该选择
+        AtomCount
+    };
+
+    explicit X11Service(QObject *parent = nullptr);
+    ~X11Service();
+
+    bool isValid() const { return m_connection != nullptr; }
+    xcb_connection_t *eventConnection() const { return m_connection; }
+    unsigned long rootWindow() const { return m_root; }
+    unsigned long atom(AtomName name) const { return m_atoms[name]; }
+
+    bool isCompositing() const;   // 一次往返，只在启动时调用
+
+    // 异步请求，调用方最后flush()一次
+    void maximizeWindow(unsigned long windowId);
+    void activateWindow(unsigned long windowId);   // 置前、输入焦点和_NET_ACTIVE_WINDOW
+    void flush();
+
+private:
+    void sendRootMessage(unsigned long windowId, unsigned long messageType, long data0, long data1, long data2);
+
+    xcb_connection_t *m_connection;          // 自己的连接（根窗口事件）
+    xcb_connection_t *m_requestConnection;   // 发送窗口操作的连接：可用时为Qt的连接，否则同m_connection
+    unsigned long m_root;
+    unsigned long m_atoms[AtomCount];
+};
+
+#endif // X11SERVICE_H
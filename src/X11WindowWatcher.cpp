@@ -0,0 +1,454 @@
+#include "X11WindowWatcher.h"
+#include "X11Service.h"
+#include <QSocketNotifier>
+#include <QAbstractEventDispatcher>
+#include <QByteArray>
+#include <QPair>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <xcb/xcb.h>
+#include <cstdlib>
+
+namespace {
+    const uint32_t TITLE_LENGTH = 2048;   // WM_NAME最多读取的长度（32位单位，与XFetchName相同）
+    const uint32_t CLASS_LENGTH = 256;    // WM_CLASS最多读取的长度（32位单位）
+
+    // WM_NAME以8位格式存储（STRING或UTF8_STRING），未设置时类型为None
+    bool titleFromReply(xcb_get_property_reply_t *reply, QString *title)
+    {
+        if (!reply || reply->type == XCB_NONE || reply->format != 8) {
+            title->clear();
+            return false;
+        }
+        *title = QString::fromUtf8(static_cast<const char *>(xcb_get_property_value(reply)),
+                                   xcb_get_property_value_length(reply));
+        return true;
+    }
+}
+#endif
+
+X11WindowWatcher::X11WindowWatcher(X11Service *x11, QObject *parent)
+    : QObject(parent)
+    , m_x11(x11)
+    , m_connection(x11 ? x11->eventConnection() : nullptr)
+    , m_root(x11 ? x11->rootWindow() : 0)
+    , m_notifier(nullptr)
+    , m_indexed(false)
+    , m_clientListDirty(true)
+    , m_active(false)
+{
+#ifdef Q_OS_LINUX
+    if (!m_connection) {
+        qDebug() << "X11显示连接无效，窗口事件监听不可用";
+        return;
+    }
+
+    // 订阅根窗口的子窗口结构变化（MapNotify）和属性变化（_NET_CLIENT_LIST）
+    const uint32_t eventMask = XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_PROPERTY_CHANGE;
+    xcb_change_window_attributes(m_connection, m_root, XCB_CW_EVENT_MASK, &eventMask);
+    xcb_flush(m_connection);
+
+    m_notifier = new QSocketNotifier(xcb_get_file_descriptor(m_connection), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &X11WindowWatcher::processPendingEvents);
+
+    // 等待回复时XCB会把顺带读到的事件放入缓冲队列而不触发套接字通知，
+    // 因此在事件循环休眠前再处理一次缓冲队列（不读取套接字）
+    QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance(thread());
+    if (dispatcher) {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [this]() {
+            dispatchEvents(false);
+        });
+    }
+
+    m_active = true;
+    qDebug() << "X11窗口事件监听已启用，文件描述符:" << xcb_get_file_descriptor(m_connection);
+#endif
+}
+
+X11WindowWatcher::~X11WindowWatcher()
+{
+#ifdef Q_OS_LINUX
+    if (m_active && m_connection) {
+        const uint32_t noEvents = XCB_EVENT_MASK_NO_EVENT;
+        xcb_change_window_attributes(m_connection, m_root, XCB_CW_EVENT_MASK, &noEvents);
+        for (auto it = m_windows.constBegin(); it != m_windows.constEnd(); ++it) {
+            xcb_change_window_attributes(m_connection, it.key(), XCB_CW_EVENT_MASK, &noEvents);
+        }
+        xcb_flush(m_connection);
+    }
+#endif
+}
+
+const QHash<unsigned long, X11WindowWatcher::WindowInfo> &X11WindowWatcher::windows()
+{
+    if (m_active && !m_indexed) {
+        rebuildIndex();
+    }
+    return m_windows;
+}
+
+const QVector<X11WindowWatcher::ClientWindow> &X11WindowWatcher::clients()
+{
+    if (m_active && m_clientListDirty) {
+        refreshClientList();
+    }
+    return m_clients;
+}
+
+qint64 X11WindowWatcher::windowPid(unsigned long windowId)
+{
+    for (const ClientWindow &client : clients()) {
+        if (client.windowId == windowId) {
+            return client.pid;
+        }
+    }
+    return 0;
+}
+
+void X11WindowWatcher::processPendingEvents()
+{
+    dispatchEvents(true);
+}
+
+void X11WindowWatcher::dispatchEvents(bool readSocket)
+{
+#ifdef Q_OS_LINUX
+    if (!m_active) {
+        return;
+    }
+
+    bool clientListDirty = false;
+    // 同一批事件中新出现的窗口和标题变化最后一起查询
+    QVector<unsigned long> created;
+    QVector<unsigned long> titleChanged;
+
+    forever {
+        xcb_generic_event_t *event = readSocket ? xcb_poll_for_event(m_connection)
+                                                : xcb_poll_for_queued_event(m_connection);
+        if (!event) {
+            if (created.isEmpty() && titleChanged.isEmpty()) {
+                break;
+            }
+            // 批量查询期间读到的新事件留在缓冲队列中，继续处理
+            addWindows(created);
+            refreshTitles(titleChanged);
+            created.clear();
+            titleChanged.clear();
+            readSocket = false;
+            continue;
+        }
+
+        switch (event->response_type & ~0x80) {
+        case 0: {
+            // 窗口可能在查询期间被销毁（BadWindow），忽略异步请求的错误
+            xcb_generic_error_t *error = reinterpret_cast<xcb_generic_error_t *>(event);
+            qDebug() << "忽略X11错误:" << error->error_code << "请求码:" << error->major_code
+                     << "资源:" << error->resource_id;
+            break;
+        }
+        case XCB_CREATE_NOTIFY: {
+            // 索引建立之前无需维护，扫描时会读取最新状态
+            xcb_create_notify_event_t *create = reinterpret_cast<xcb_create_notify_event_t *>(event);
+            if (m_indexed && create->parent == m_root) {
+                created.append(create->window);
+            }
+            break;
+        }
+        case XCB_DESTROY_NOTIFY: {
+            xcb_destroy_notify_event_t *destroy = reinterpret_cast<xcb_destroy_notify_event_t *>(event);
+            m_windows.remove(destroy->window);
+            created.removeAll(destroy->window);
+            titleChanged.removeAll(destroy->window);
+            break;
+        }
+        case XCB_REPARENT_NOTIFY: {
+            // 被窗口管理器装饰框接管后不再是顶层窗口；重新挂到根窗口时重新索引
+            if (!m_indexed) {
+                break;
+            }
+            xcb_reparent_notify_event_t *reparent = reinterpret_cast<xcb_reparent_notify_event_t *>(event);
+            if (reparent->parent == m_root) {
+                created.append(reparent->window);
+            } else {
+                created.removeAll(reparent->window);
+                titleChanged.removeAll(reparent->window);
+                if (m_windows.remove(reparent->window) > 0) {
+                    const uint32_t noEvents = XCB_EVENT_MASK_NO_EVENT;
+                    xcb_change_window_attributes(m_connection, reparent->window, XCB_CW_EVENT_MASK, &noEvents);
+                }
+            }
+            break;
+        }
+        case XCB_MAP_NOTIFY: {
+            xcb_map_notify_event_t *map = reinterpret_cast<xcb_map_notify_event_t *>(event);
+            auto it = m_windows.find(map->window);
+            if (it != m_windows.end()) {
+                it.value().viewable = true;
+            }
+            if (!map->override_redirect) {
+                emit windowMapped(map->window);
+            }
+            break;
+        }
+        case XCB_UNMAP_NOTIFY: {
+            xcb_unmap_notify_event_t *unmap = reinterpret_cast<xcb_unmap_notify_event_t *>(event);
+            auto it = m_windows.find(unmap->window);
+            if (it != m_windows.end()) {
+                it.value().viewable = false;
+            }
+            break;
+        }
+        case XCB_CONFIGURE_NOTIFY: {
+            xcb_configure_notify_event_t *configure = reinterpret_cast<xcb_configure_notify_event_t *>(event);
+            auto it = m_windows.find(configure->window);
+            if (it != m_windows.end()) {
+                WindowInfo &info = it.value();
+                bool resized = info.width != configure->width || info.height != configure->height;
+                info.x = configure->x;
+                info.y = configure->y;
+                info.width = configure->width;
+                info.height = configure->height;
+                if (resized) {
+                    emit windowChanged(it.key());
+                }
+            }
+            break;
+        }
+        case XCB_PROPERTY_NOTIFY: {
+            xcb_property_notify_event_t *property = reinterpret_cast<xcb_property_notify_event_t *>(event);
+            if (property->window == m_root) {
+                if (property->atom == m_x11->atom(X11Service::NetClientList)) {
+                    clientListDirty = true;
+                    m_clientListDirty = true;
+                }
+            } else if (property->atom == XCB_ATOM_WM_NAME || property->atom == m_x11->atom(X11Service::NetWmName)) {
+                if (!titleChanged.contains(property->window)) {
+                    titleChanged.append(property->window);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        free(event);
+    }
+
+    // 同一批事件中的多次列表变化只通知一次
+    if (clientListDirty) {
+        emit clientListChanged();
+    }
+#else
+    Q_UNUSED(readSocket)
+#endif
+}
+
+void X11WindowWatcher::rebuildIndex()
+{
+#ifdef Q_OS_LINUX
+    // 根窗口事件已先订阅，扫描期间创建的窗口会通过CreateNotify补上
+    m_windows.clear();
+    m_indexed = true;
+
+    xcb_query_tree_reply_t *tree = xcb_query_tree_reply(m_connection, xcb_query_tree(m_connection, m_root), nullptr);
+    if (!tree) {
+        qDebug() << "❌ 无法获取窗口树，窗口索引为空";
+        return;
+    }
+
+    const xcb_window_t *children = xcb_query_tree_children(tree);
+    const int childCount = xcb_query_tree_children_length(tree);
+    QVector<unsigned long> windowIds;
+    windowIds.reserve(childCount);
+    for (int i = 0; i < childCount; ++i) {
+        windowIds.append(children[i]);
+    }
+    free(tree);
+
+    m_windows.reserve(childCount);
+    addWindows(windowIds);
+    qDebug() << "窗口索引已建立，顶层窗口数:" << m_windows.size();
+#endif
+}
+
+void X11WindowWatcher::addWindows(const QVector<unsigned long> &windowIds)
+{
+#ifdef Q_OS_LINUX
+    if (windowIds.isEmpty()) {
+        return;
+    }
+
+    struct PendingWindow {
+        xcb_window_t window;
+        xcb_get_window_attributes_cookie_t attributes;
+        xcb_get_geometry_cookie_t geometry;
+        xcb_get_property_cookie_t title;
+    };
+
+    // 先订阅属性变化，再读取当前值，避免错过两者之间的标题更新；
+    // 所有窗口的请求一起发出，下面收取回复时只等待一次往返
+    const uint32_t eventMask = XCB_EVENT_MASK_PROPERTY_CHANGE;
+    QVector<PendingWindow> pending;
+    pending.reserve(windowIds.size());
+    for (unsigned long windowId : windowIds) {
+        xcb_change_window_attributes(m_connection, windowId, XCB_CW_EVENT_MASK, &eventMask);
+        PendingWindow request;
+        request.window = windowId;
+        request.attributes = xcb_get_window_attributes(m_connection, windowId);
+        request.geometry = xcb_get_geometry(m_connection, windowId);
+        request.title = xcb_get_property(m_connection, 0, windowId, XCB_ATOM_WM_NAME, XCB_GET_PROPERTY_TYPE_ANY,
+                                         0, TITLE_LENGTH);
+        pending.append(request);
+    }
+
+    for (const PendingWindow &request : qAsConst(pending)) {
+        // 每个cookie都要取回复，否则回复会一直留在连接中
+        xcb_get_window_attributes_reply_t *attributes = xcb_get_window_attributes_reply(m_connection, request.attributes, nullptr);
+        xcb_get_geometry_reply_t *geometry = xcb_get_geometry_reply(m_connection, request.geometry, nullptr);
+        xcb_get_property_reply_t *title = xcb_get_property_reply(m_connection, request.title, nullptr);
+
+        // 窗口已被销毁（BadWindow），随后的DestroyNotify无需处理
+        if (attributes && geometry) {
+            WindowInfo info;
+            info.viewable = attributes->map_state == XCB_MAP_STATE_VIEWABLE;
+            info.x = geometry->x;
+            info.y = geometry->y;
+            info.width = geometry->width;
+            info.height = geometry->height;
+            info.hasTitle = titleFromReply(title, &info.title);
+            m_windows.insert(request.window, info);
+            if (info.hasTitle) {
+                emit windowChanged(request.window);
+            }
+        }
+
+        free(attributes);
+        free(geometry);
+        free(title);
+    }
+#else
+    Q_UNUSED(windowIds)
+#endif
+}
+
+void X11WindowWatcher::refreshTitles(const QVector<unsigned long> &windowIds)
+{
+#ifdef Q_OS_LINUX
+    QVector<QPair<unsigned long, xcb_get_property_cookie_t>> pending;
+    pending.reserve(windowIds.size());
+    for (unsigned long windowId : windowIds) {
+        if (m_windows.contains(windowId)) {
+            pending.append(qMakePair(windowId, xcb_get_property(m_connection, 0, windowId, XCB_ATOM_WM_NAME,
+                                                                XCB_GET_PROPERTY_TYPE_ANY, 0, TITLE_LENGTH)));
+        }
+    }
+
+    for (const auto &request : qAsConst(pending)) {
+        xcb_get_property_reply_t *reply = xcb_get_property_reply(m_connection, request.second, nullptr);
+        QString title;
+        bool hasTitle = titleFromReply(reply, &title);
+        free(reply);
+
+        auto it = m_windows.find(request.first);
+        if (it == m_windows.end()) {
+            continue;
+        }
+        WindowInfo &info = it.value();
+        if (info.hasTitle == hasTitle && info.title == title) {
+            continue;
+        }
+        info.hasTitle = hasTitle;
+        info.title = title;
+        emit windowChanged(request.first);
+    }
+#else
+    Q_UNUSED(windowIds)
+#endif
+}
+
+void X11WindowWatcher::refreshClientList()
+{
+#ifdef Q_OS_LINUX
+    m_clientListDirty = false;
+
+    xcb_get_property_reply_t *list = xcb_get_property_reply(
+        m_connection,
+        xcb_get_property(m_connection, 0, m_root, m_x11->atom(X11Service::NetClientList),
+                         XCB_ATOM_WINDOW, 0, 0x7fffffff),
+        nullptr);
+    if (!list || list->type == XCB_NONE || list->format != 32) {
+        qDebug() << "无法读取_NET_CLIENT_LIST（窗口管理器可能不支持EWMH）";
+        free(list);
+        m_clients.clear();
+        return;
+    }
+
+    // 已知窗口的PID和WM_CLASS不会改变，直接沿用
+    QHash<unsigned long, ClientWindow> known;
+    known.reserve(m_clients.size());
+    for (const ClientWindow &client : qAsConst(m_clients)) {
+        known.insert(client.windowId, client);
+    }
+
+    struct PendingClient {
+        int index;
+        xcb_get_property_cookie_t pid;
+        xcb_get_property_cookie_t wmClass;
+    };
+
+    // 新窗口的_NET_WM_PID和WM_CLASS请求一起发出，再统一收取回复
+    const xcb_window_t *windowIds = static_cast<const xcb_window_t *>(xcb_get_property_value(list));
+    const int windowCount = static_cast<int>(list->value_len);
+    QVector<ClientWindow> clients;
+    clients.reserve(windowCount);
+    QVector<PendingClient> pending;
+    for (int i = 0; i < windowCount; ++i) {
+        auto it = known.constFind(windowIds[i]);
+        if (it != known.constEnd()) {
+            clients.append(it.value());
+            continue;
+        }
+
+        ClientWindow client;
+        client.windowId = windowIds[i];
+        clients.append(client);
+
+        PendingClient request;
+        request.index = clients.size() - 1;
+        request.pid = xcb_get_property(m_connection, 0, windowIds[i], m_x11->atom(X11Service::NetWmPid),
+                                       XCB_ATOM_CARDINAL, 0, 1);
+        request.wmClass = xcb_get_property(m_connection, 0, windowIds[i], XCB_ATOM_WM_CLASS,
+                                           XCB_ATOM_STRING, 0, CLASS_LENGTH);
+        pending.append(request);
+    }
+    free(list);
+
+    for (const PendingClient &request : qAsConst(pending)) {
+        ClientWindow &client = clients[request.index];
+
+        xcb_get_property_reply_t *pid = xcb_get_property_reply(m_connection, request.pid, nullptr);
+        if (pid && pid->format == 32 && pid->value_len > 0) {
+            client.pid = static_cast<qint64>(*static_cast<const uint32_t *>(xcb_get_property_value(pid)));
+        }
+        free(pid);
+
+        // WM_CLASS为"res_name\0res_class\0"
+        xcb_get_property_reply_t *wmClass = xcb_get_property_reply(m_connection, request.wmClass, nullptr);
+        if (wmClass && wmClass->format == 8) {
+            const char *value = static_cast<const char *>(xcb_get_property_value(wmClass));
+            const uint length = static_cast<uint>(xcb_get_property_value_length(wmClass));
+            const uint nameLength = qstrnlen(value, length);
+            client.wmInstance = QString::fromLocal8Bit(value, static_cast<int>(nameLength));
+            if (nameLength + 1 < length) {
+                const char *className = value + nameLength + 1;
+                client.wmClass = QString::fromLocal8Bit(className,
+                                                        static_cast<int>(qstrnlen(className, length - nameLength - 1)));
+            }
+        }
+        free(wmClass);
+    }
+
+    m_clients.swap(clients);
+#endif
+}
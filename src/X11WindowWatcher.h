@@ -0,0 +1,98 @@
+#ifndef X11WINDOWWATCHER_H
+#define X11WINDOWWATCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class QSocketNotifier;
+class X11Service;
+
+// XCB前置声明（非Linux平台下仅作占位类型）
+typedef struct xcb_connection_t xcb_connection_t;
+
+/**
+ * @brief X11窗口事件监听器
+ *
+ * 在根窗口上选择SubstructureNotifyMask/PropertyChangeMask，
+ * 通过QSocketNotifier监听X连接的文件描述符，
+ * 在顶层窗口映射(MapNotify)或_NET_CLIENT_LIST变化时立即发出信号，
+ * 取代固定延迟+定时重试的窗口搜索方式。
+ *
+ * 同时维护顶层窗口索引（标题、尺寸、可见状态）：首次查找时完整扫描一次，
+ * 之后根据Create/Destroy/Map/Unmap/Configure/Reparent和WM_NAME属性事件增量更新，
+ * 按标题查找窗口只需遍历内存中的索引，不再产生X服务器往返。
+ * 扫描和读取属性使用XCB的cookie/reply模型：所有窗口的请求先全部发出，再统一收取回复，
+ * N个窗口的扫描只有约一次往返的延迟（通过SSH X转发使用时尤其明显）。
+ *
+ * 另外缓存窗口管理器的_NET_CLIENT_LIST及各客户端窗口的_NET_WM_PID/WM_CLASS，
+ * 用于把窗口绑定到启动器自己启动的进程。
+ * 连接和原子来自X11Service（事件连接只由本类读取）
+ */
+class X11WindowWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 顶层窗口的缓存信息
+    struct WindowInfo {
+        QString title;
+        bool hasTitle = false;   // 是否设置了WM_NAME（空标题与未设置不同）
+        bool viewable = false;   // 已映射（根窗口的子窗口映射即可见）
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // _NET_CLIENT_LIST中的客户端窗口（按映射顺序）
+    struct ClientWindow {
+        unsigned long windowId = 0;
+        qint64 pid = 0;          // _NET_WM_PID，未设置时为0
+        QString wmInstance;      // WM_CLASS的res_name
+        QString wmClass;         // WM_CLASS的res_class
+    };
+
+    explicit X11WindowWatcher(X11Service *x11, QObject *parent = nullptr);
+    ~X11WindowWatcher();
+
+    // 是否已成功订阅根窗口事件
+    bool isActive() const { return m_active; }
+
+    // 当前所有顶层窗口（按XID索引）；首次调用时建立索引，避免拖慢启动
+    const QHash<unsigned long, WindowInfo> &windows();
+
+    // 当前客户端窗口列表；列表变化后首次调用时重新读取，新窗口的PID和WM_CLASS只读取一次
+    const QVector<ClientWindow> &clients();
+
+    // 客户端窗口的_NET_WM_PID（使用缓存，未知时为0）
+    qint64 windowPid(unsigned long windowId);
+
+signals:
+    void windowMapped(unsigned long windowId);  // 顶层窗口被映射
+    void clientListChanged();                   // 窗口管理器更新了_NET_CLIENT_LIST
+    void windowChanged(unsigned long windowId); // 已索引窗口的标题或尺寸发生变化
+
+private slots:
+    void processPendingEvents();  // 读取并分发X连接中的所有事件
+
+private:
+    void dispatchEvents(bool readSocket);       // readSocket为false时只处理已读入缓冲区的事件
+    void rebuildIndex();                        // 完整扫描根窗口的子窗口（仅一次）
+    void addWindows(const QVector<unsigned long> &windowIds);   // 订阅属性变化并批量读取窗口信息
+    void refreshTitles(const QVector<unsigned long> &windowIds);
+    void refreshClientList();
+
+    X11Service *m_x11;
+    xcb_connection_t *m_connection;
+    unsigned long m_root;
+    QSocketNotifier *m_notifier;
+    QHash<unsigned long, WindowInfo> m_windows;
+    bool m_indexed;
+    QVector<ClientWindow> m_clients;
+    bool m_clientListDirty;
+    bool m_active;
+};
+
+#endif // X11WINDOWWATCHER_H
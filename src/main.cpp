@@ -4,7 +4,18 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QLoggingCategory>
+#include <QCommandLineParser>
+#include <QLockFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cstdio>
+#include "ControlServer.h"
 #include "FlightControlsLauncher.h"
+#include "Supervisor.h"
+#include "AppRegistry.h"
+#include "RosEnvironment.h"
+#include "StartupTrace.h"
+#include "DragBenchmark.h"
 
 // 简化的日志处理，兼容Qt 5.9
 #define qDebugLauncher qDebug
@@ -27,9 +38,125 @@ bool initializeApplication()
     return true;
 }
 
+// 把命令转发给运行中的启动器或守护进程，回复（JSON）输出到标准输出
+int forwardToRunningInstance(int argc, char *argv[], ControlServer::Instance instance,
+                             const QStringList &commands, bool printReplies)
+{
+    QCoreApplication client(argc, argv);
+    QStringList replies;
+    QString error;
+    if (!ControlServer::send(instance, commands, &replies, &error)) {
+        qCriticalLauncher() << error;
+        return 1;
+    }
+    
+    int result = 0;
+    for (const QString &reply : replies) {
+        if (printReplies) {
+            fprintf(stdout, "%s\n", reply.toUtf8().constData());
+        }
+        if (!QJsonDocument::fromJson(reply.toUtf8()).object().value("ok").toBool()) {
+            result = 1;
+        }
+    }
+    return result;
+}
+
 int main(int argc, char *argv[])
 {
+    StartupTrace::start();
+    
+    // 命令行参数（先于QApplication解析：已有实例运行时无需创建窗口系统连接）
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription("飞行控制应用程序浮动启动器");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption refreshRosEnvOption("refresh-ros-env", "丢弃缓存的ROS环境快照，下次启动RVIZ时重新source setup.bash");
+    parser.addOption(refreshRosEnvOption);
+    QCommandLineOption traceStartupOption("trace-startup",
+        "记录启动各阶段耗时，首帧绘制后以Chrome trace JSON格式写入<file>", "file");
+    parser.addOption(traceStartupOption);
+    QCommandLineOption traceStartupQuitOption("trace-startup-quit",
+        "写出启动跟踪后立即退出（用于启动基准测试）");
+    parser.addOption(traceStartupQuitOption);
+    QCommandLineOption appsOption("apps",
+        "从<file>加载应用程序注册表（默认使用配置目录中的applications.json，不存在时使用内置配置）", "file");
+    parser.addOption(appsOption);
+    QCommandLineOption profileOption("profile",
+        "启动后立即运行applications.json中的启动配置<name>（例如开机自启动时使用mission）", "name");
+    parser.addOption(profileOption);
+    QCommandLineOption prewarmOption(QStringList() << "prewarm" << "prewarm-qgc",
+        "在后台把声明了prewarm的AppImage（如QGroundControl）解包到应用程序数据目录并预读，"
+        "之后直接执行解包后的程序（占用约数百MB磁盘空间）");
+    parser.addOption(prewarmOption);
+    QCommandLineOption dragModeOption("drag-mode",
+        "拖动启动器的方式：system（由窗口管理器移动，默认）、coalesced（按屏幕刷新率合并）或immediate", "mode", "system");
+    parser.addOption(dragModeOption);
+    QCommandLineOption benchmarkDragOption("benchmark-drag",
+        "显示后模拟3秒拖动，把丢帧数和CPU时间写入<file>后退出（用于拖动基准测试）", "file");
+    parser.addOption(benchmarkDragOption);
+    QCommandLineOption showOption("show", "显示运行中的启动器（已有实例时的默认命令）");
+    parser.addOption(showOption);
+    QCommandLineOption startOption("start", "启动应用程序<id>（可重复，已有实例时转发给该实例）", "id");
+    parser.addOption(startOption);
+    QCommandLineOption stopOption("stop", "停止运行中实例的应用程序<id>（可重复）", "id");
+    parser.addOption(stopOption);
+    QCommandLineOption stopAllOption("stop-all", "停止运行中实例的所有应用程序");
+    parser.addOption(stopAllOption);
+    QCommandLineOption statusOption("status", "以JSON格式输出运行中实例的状态");
+    parser.addOption(statusOption);
+    
+    // 单实例：已有启动器持有锁时把命令转发给它后立即退出。
+    // 守护进程的锁：守护进程在运行时委托给它；否则由启动器持有，自己监管期间守护进程无法启动
+    QLockFile instanceLock(ControlServer::lockPath(ControlServer::Instance::Launcher));
+    QLockFile daemonLock(ControlServer::lockPath(ControlServer::Instance::Daemon));
+    bool daemonRunning = false;
+    if (parser.parse(arguments) && !parser.isSet("help") && !parser.isSet("version")) {
+        QStringList commands;
+        for (const QString &appId : parser.values(startOption)) {
+            commands << "start " + appId;
+        }
+        for (const QString &appId : parser.values(stopOption)) {
+            commands << "stop " + appId;
+        }
+        if (parser.isSet(stopAllOption)) {
+            commands << "stop-all";
+        }
+        if (parser.isSet(profileOption)) {
+            commands << "profile " + parser.value(profileOption);
+        }
+        if (parser.isSet(statusOption)) {
+            commands << "status";
+        }
+        bool controlOnly = parser.isSet(stopOption) || parser.isSet(stopAllOption) || parser.isSet(statusOption);
+        
+        if (!instanceLock.tryLock(0)) {
+            // 只有默认的show时不输出回复
+            bool printReplies = !commands.isEmpty();
+            if (parser.isSet(showOption) || commands.isEmpty()) {
+                commands.prepend("show");
+            }
+            return forwardToRunningInstance(argc, argv, ControlServer::Instance::Launcher, commands, printReplies);
+        }
+        daemonRunning = !daemonLock.tryLock(0);
+        if (controlOnly) {
+            // 停止和查询只针对运行中的实例，不启动新的启动器
+            if (daemonRunning) {
+                return forwardToRunningInstance(argc, argv, ControlServer::Instance::Daemon, commands, true);
+            }
+            fprintf(stderr, "没有运行中的启动器或监管守护进程\n");
+            return parser.isSet(statusOption) ? 1 : 0;
+        }
+    }
+    
+    StartupTrace::begin("QApplication");
     QApplication app(argc, argv);
+    StartupTrace::end("QApplication");
     
     // 设置应用程序信息
     app.setApplicationName("FlightControls Launcher");
@@ -41,6 +168,12 @@ int main(int argc, char *argv[])
     // 设置应用程序样式
     app.setStyle("Fusion");
     
+    parser.process(app);
+    
+    if (parser.isSet(traceStartupOption)) {
+        StartupTrace::enable(parser.value(traceStartupOption), parser.isSet(traceStartupQuitOption));
+    }
+    
     // 初始化日志
     qDebugLauncher() << "========================================";
     qDebugLauncher() << "启动飞行控制应用程序启动器 v5.0";
@@ -50,21 +183,104 @@ int main(int argc, char *argv[])
     qDebugLauncher() << "========================================";
     
     // 检查基本环境
+    StartupTrace::begin("initializeApplication");
     if (!initializeApplication()) {
         QMessageBox::critical(nullptr, "初始化错误", "应用程序初始化失败，请检查权限设置。");
         return 1;
     }
+    StartupTrace::end("initializeApplication");
+    
+    if (parser.isSet(refreshRosEnvOption) && !RosEnvironment::clearSnapshot()) {
+        qWarningLauncher() << "无法删除ROS环境快照:" << RosEnvironment::snapshotPath();
+    }
+    
+    // 加载应用程序注册表，配置有误时提示并回退到内置配置
+    StartupTrace::begin("AppRegistry");
+    AppRegistry registry;
+    QString registryError;
+    if (!registry.load(parser.value(appsOption), &registryError)) {
+        qWarningLauncher() << "加载应用程序注册表失败:" << registryError;
+        QMessageBox::warning(nullptr, "配置错误",
+            QString("应用程序配置无效，将使用内置配置:\n%1").arg(registryError));
+        if (!registry.load(AppRegistry::builtinPath(), &registryError)) {
+            qCriticalLauncher() << "内置应用程序注册表无效:" << registryError;
+            return 1;
+        }
+    }
+    StartupTrace::end("AppRegistry");
+    qDebugLauncher() << "应用程序注册表:" << registry.sourcePath();
     
     try {
+        // 监管核心（启动、停止和重启），启动器窗口是它的客户端；守护进程在运行时委托给它
+        Supervisor supervisor(registry);
+        if (daemonRunning) {
+            QString daemonError;
+            if (!supervisor.attachToDaemon(ControlServer::socketPath(ControlServer::Instance::Daemon), &daemonError)) {
+                qCriticalLauncher() << daemonError;
+                QMessageBox::critical(nullptr, "启动错误",
+                    QString("监管守护进程正在运行，但无法连接到它:\n%1").arg(daemonError));
+                return 1;
+            }
+        }
+        
         // 创建浮动启动器
-        FlightControlsLauncher launcher;
+        StartupTrace::begin("FlightControlsLauncher");
+        FlightControlsLauncher launcher(&supervisor);
+        StartupTrace::end("FlightControlsLauncher");
         
         // 设置窗口标题
         launcher.setWindowTitle("飞行控制应用程序启动器 v5.0");
         
+        QString dragModeName = parser.value(dragModeOption);
+        FlightControlsLauncher::DragMode dragMode;
+        if (!FlightControlsLauncher::parseDragMode(dragModeName, &dragMode)) {
+            qWarningLauncher() << "无效的拖动方式:" << dragModeName << "，使用system";
+            dragModeName = "system";
+            dragMode = FlightControlsLauncher::DragMode::System;
+        }
+        if (parser.isSet(benchmarkDragOption) && dragMode == FlightControlsLauncher::DragMode::System) {
+            // 合成的鼠标事件不能交给窗口管理器（会抓取真实指针）
+            dragModeName = "coalesced";
+            dragMode = FlightControlsLauncher::DragMode::Coalesced;
+        }
+        launcher.setDragMode(dragMode);
+        
+        if (parser.isSet(prewarmOption)) {
+            supervisor.enablePrewarm();
+        }
+        
         // 显示启动器
+        StartupTrace::watchFirstFrame(&launcher);
+        StartupTrace::begin("show");
         launcher.show();
+        StartupTrace::end("show");
         
+        if (parser.isSet(benchmarkDragOption)) {
+            DragBenchmark::start(&launcher, dragModeName, parser.value(benchmarkDragOption));
+        }
+        
+        if (parser.isSet(profileOption) && !supervisor.startProfile(parser.value(profileOption))) {
+            QStringList profileIds;
+            for (const LaunchProfile &profile : registry.profiles()) {
+                profileIds << profile.id;
+            }
+            qCriticalLauncher() << "未定义的启动配置:" << parser.value(profileOption)
+                                << "可用的启动配置:" << profileIds;
+            return 1;
+        }
+        for (const QString &appId : parser.values(startOption)) {
+            if (!supervisor.startApplication(appId)) {
+                qWarningLauncher() << "未定义的应用程序:" << appId;
+            }
+        }
+        
+        // 控制套接字：后续运行的启动器和自动化脚本通过它控制本实例
+        ControlServer controlServer(&supervisor, ControlServer::Instance::Launcher);
+        QObject::connect(&controlServer, &ControlServer::showRequested, &launcher, &FlightControlsLauncher::activate);
+        QString controlError;
+        if (!controlServer.listen(&controlError)) {
+            qWarningLauncher() << "无法监听控制套接字:" << controlError;
+        }
         
         int result = app.exec();
         
@@ -2,6 +2,7 @@
 #define QT_COMPATIBILITY_H
 
 #include <QtGlobal>
+#include <QProcess>
 
 // Qt版本兼容性处理
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
@@ -10,8 +11,6 @@
     #endif
     
     // Qt 5.9兼容性定义
-    #include <QProcess>
-    
     // QProcess::finished信号在Qt 5.6+中有两个重载版本
     // 在Qt 5.15中，旧版本被标记为deprecated
     // 为了兼容Qt 5.9，我们使用旧版本的信号连接方式
@@ -40,4 +39,18 @@
     }
 #endif
 
+// 字符串分割（Qt 5.14起QString::SkipEmptyParts被弃用，Qt::SkipEmptyParts在5.9中不存在）
+#include <QString>
+#include <QStringList>
+
+namespace QtCompat {
+    inline QStringList splitSkipEmpty(const QString &text, QChar separator) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        return text.split(separator, Qt::SkipEmptyParts);
+#else
+        return text.split(separator, QString::SkipEmptyParts);
+#endif
+    }
+}
+
 #endif // QT_COMPATIBILITY_H
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QStandardPaths>
+#include <QDir>
+#include <QCommandLineParser>
+#include <QLockFile>
+#include <QSocketNotifier>
+#include <cstdio>
+#include <cstring>
+#include "AppRegistry.h"
+#include "ControlServer.h"
+#include "RosEnvironment.h"
+#include "Supervisor.h"
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef Q_OS_UNIX
+    // SIGTERM/SIGINT处理函数只写一个字节，停止流程在事件循环中执行
+    int signalSocket[2] = {-1, -1};
+
+    void handleTerminationSignal(int)
+    {
+        char byte = 1;
+        ssize_t written = ::write(signalSocket[0], &byte, sizeof(byte));
+        Q_UNUSED(written)
+    }
+
+    bool installTerminationHandler()
+    {
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalSocket) != 0) {
+            return false;
+        }
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = handleTerminationSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        return ::sigaction(SIGTERM, &action, nullptr) == 0 && ::sigaction(SIGINT, &action, nullptr) == 0;
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    
+    // 与浮动启动器使用相同的应用程序信息：共用配置目录、ROS环境快照和预热缓存
+    app.setApplicationName("FlightControls Launcher");
+    app.setApplicationVersion("5.0");
+    app.setOrganizationName("FlightControls");
+    app.setOrganizationDomain("flightcontrols.org");
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription("飞行控制应用程序监管守护进程（无界面，通过控制套接字或flight_controls_launcher控制）");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption refreshRosEnvOption("refresh-ros-env", "丢弃缓存的ROS环境快照，下次启动ROS应用时重新source setup.bash");
+    parser.addOption(refreshRosEnvOption);
+    QCommandLineOption appsOption("apps",
+        "从<file>加载应用程序注册表（默认使用配置目录中的applications.json，不存在时使用内置配置）", "file");
+    parser.addOption(appsOption);
+    QCommandLineOption profileOption("profile", "启动后立即运行applications.json中的启动配置<name>", "name");
+    parser.addOption(profileOption);
+    QCommandLineOption startOption("start", "启动后立即启动应用程序<id>（可重复）", "id");
+    parser.addOption(startOption);
+    QCommandLineOption prewarmOption("prewarm", "在后台解包并预读声明了prewarm的AppImage");
+    parser.addOption(prewarmOption);
+    parser.process(app);
+    
+    // 自己监管应用程序的浮动启动器也持有这个锁，同时只能有一个监管实例
+    QLockFile instanceLock(ControlServer::lockPath(ControlServer::Instance::Daemon));
+    if (!instanceLock.tryLock(0)) {
+        fprintf(stderr, "已有监管实例在运行（浮动启动器或另一个守护进程，%s）\n",
+                qPrintable(ControlServer::lockPath(ControlServer::Instance::Daemon)));
+        return 1;
+    }
+    
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (!QDir().mkpath(appDataPath)) {
+        qCritical() << "无法创建应用程序数据目录:" << appDataPath;
+        return 1;
+    }
+    
+    if (parser.isSet(refreshRosEnvOption) && !RosEnvironment::clearSnapshot()) {
+        qWarning() << "无法删除ROS环境快照:" << RosEnvironment::snapshotPath();
+    }
+    
+    // 无界面运行时配置有误直接退出，不回退到内置配置
+    AppRegistry registry;
+    QString registryError;
+    if (!registry.load(parser.value(appsOption), &registryError)) {
+        qCritical() << "加载应用程序注册表失败:" << registryError;
+        return 1;
+    }
+    qDebug() << "应用程序注册表:" << registry.sourcePath();
+    
+    Supervisor supervisor(registry);
+    QObject::connect(&supervisor, &Supervisor::launchFailed, [](int, const QString &message) {
+        qCritical() << "启动失败:" << message;
+    });
+    QObject::connect(&supervisor, &Supervisor::restartAbandoned, [](int, const QString &reason) {
+        qCritical() << reason;
+    });
+    
+    // 收到SIGTERM/SIGINT后停止所有应用程序，全部停止后退出
+#ifdef Q_OS_UNIX
+    if (!installTerminationHandler()) {
+        qWarning() << "无法安装SIGTERM/SIGINT处理函数";
+    } else {
+        QSocketNotifier *signalNotifier = new QSocketNotifier(signalSocket[1], QSocketNotifier::Read, &app);
+        QObject::connect(signalNotifier, &QSocketNotifier::activated, [&supervisor, &app](int socket) {
+            char byte;
+            ssize_t received = ::read(socket, &byte, sizeof(byte));
+            Q_UNUSED(received)
+            if (supervisor.isShuttingDown()) {
+                return;
+            }
+            qDebug() << "收到终止信号，停止所有应用程序...";
+            QObject::connect(&supervisor, &Supervisor::allApplicationsStopped, &app, &QCoreApplication::quit);
+            supervisor.shutdown();
+        });
+    }
+#endif
+    
+    if (parser.isSet(prewarmOption)) {
+        supervisor.enablePrewarm();
+    }
+    if (parser.isSet(profileOption) && !supervisor.startProfile(parser.value(profileOption))) {
+        return 1;
+    }
+    for (const QString &appId : parser.values(startOption)) {
+        if (!supervisor.startApplication(appId)) {
+            qWarning() << "未定义的应用程序:" << appId;
+        }
+    }
+    
+    ControlServer controlServer(&supervisor, ControlServer::Instance::Daemon);
+    QString controlError;
+    if (!controlServer.listen(&controlError)) {
+        qCritical() << "无法监听控制套接字:" << controlError;
+        return 1;
+    }
+    
+    return app.exec();
+}
@@ -0,0 +1,88 @@
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include "AppImagePrewarmer.h"
+
+/**
+ * @brief AppImage预热缓存清理：每个声明prewarm的应用各有一个预热器，互不删除对方的缓存
+ */
+class AppImagePrewarmerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void keepsOtherApplicationsCaches();
+
+private:
+    QString writeFakeAppImage(const QString &name);
+
+    QTemporaryDir m_appImageDir;
+};
+
+void AppImagePrewarmerTest::initTestCase()
+{
+    // 缓存写到测试专用的AppDataLocation
+    QStandardPaths::setTestModeEnabled(true);
+    QCoreApplication::setOrganizationName("FlightControls");
+    QCoreApplication::setApplicationName("FlightControls Launcher Test");
+    QVERIFY(m_appImageDir.isValid());
+}
+
+void AppImagePrewarmerTest::init()
+{
+    QDir(AppImagePrewarmer::cacheRoot()).removeRecursively();
+}
+
+QString AppImagePrewarmerTest::writeFakeAppImage(const QString &name)
+{
+    // 与真实AppImage一样，--appimage-extract在当前目录生成squashfs-root/AppRun
+    const QString path = m_appImageDir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    file.write("#!/bin/sh\n"
+               "mkdir -p squashfs-root\n"
+               "printf '#!/bin/sh\\n' > squashfs-root/AppRun\n"
+               "chmod +x squashfs-root/AppRun\n");
+    file.close();
+    file.setPermissions(file.permissions() | QFileDevice::ExeOwner);
+    return path;
+}
+
+void AppImagePrewarmerTest::keepsOtherApplicationsCaches()
+{
+    const QString qgcAppImage = writeFakeAppImage("QGroundControl.AppImage");
+    const QString rvizAppImage = writeFakeAppImage("RViz.AppImage");
+    QVERIFY(!qgcAppImage.isEmpty());
+    QVERIFY(!rvizAppImage.isEmpty());
+
+    // 其他应用正在解包的目录，以及QGroundControl更新前留下的旧缓存
+    QDir root(AppImagePrewarmer::cacheRoot());
+    QVERIFY(root.mkpath("Other-0123456789ab.partial/squashfs-root"));
+    QVERIFY(root.mkpath("QGroundControl-ffffffffffff/squashfs-root"));
+
+    AppImagePrewarmer qgcPrewarmer;
+    AppImagePrewarmer rvizPrewarmer;
+    QSignalSpy qgcReady(&qgcPrewarmer, &AppImagePrewarmer::ready);
+    QSignalSpy rvizReady(&rvizPrewarmer, &AppImagePrewarmer::ready);
+    qgcPrewarmer.start(qgcAppImage);
+    rvizPrewarmer.start(rvizAppImage);
+    QVERIFY(qgcReady.count() > 0 || qgcReady.wait(5000));
+    QVERIFY(rvizReady.count() > 0 || rvizReady.wait(5000));
+
+    // 后完成的解包不能删除先完成的缓存
+    QVERIFY(QFileInfo(qgcPrewarmer.executable()).isExecutable());
+    QVERIFY(QFileInfo(rvizPrewarmer.executable()).isExecutable());
+    QVERIFY(root.exists("Other-0123456789ab.partial/squashfs-root"));
+    QVERIFY(!root.exists("QGroundControl-ffffffffffff"));
+}
+
+QTEST_GUILESS_MAIN(AppImagePrewarmerTest)
+#include "test_appimage_prewarmer.moc"